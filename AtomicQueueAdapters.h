@@ -1,8 +1,21 @@
 #ifndef ATOMICQUEUEADAPTERS_H
 #define ATOMICQUEUEADAPTERS_H
 
+#include "ConcurrentQueueConcept.h"
+#include "QueueTypeTraits.h"
 #include "atomic_queue/atomic_queue.h"
 
+#include <atomic>
+#include <type_traits>
+
+// AtomicQueue keeps elements in std::atomic<T>, which only works for lock-free T; larger elements
+// go in AtomicQueue2, which guards each slot with a state flag instead.
+template <typename T, unsigned SIZE, bool MINIMIZE_CONTENTION, bool MAXIMIZE_THROUGHPUT, bool SPSC>
+using AtomicQueueFor = std::conditional_t<
+    std::atomic<T>::is_always_lock_free,
+    atomic_queue::AtomicQueue<T, SIZE, T{}, MINIMIZE_CONTENTION, MAXIMIZE_THROUGHPUT, false, SPSC>,
+    atomic_queue::AtomicQueue2<T, SIZE, MINIMIZE_CONTENTION, MAXIMIZE_THROUGHPUT, false, SPSC>>;
+
 template <typename T, unsigned SIZE>
 class AtomicQueueSPSCAdapter {
 public:
@@ -18,9 +31,12 @@ public:
         return true;
     }
 
+    bool try_push(const T& item) { return queue_.try_push(item); }
+
+    bool try_pop(T& item) { return queue_.try_pop(item); }
+
 private:
-    atomic_queue::RetryDecorator<atomic_queue::AtomicQueue<T, SIZE, T{}, false, false, false, true>>
-        queue_;
+    atomic_queue::RetryDecorator<AtomicQueueFor<T, SIZE, false, false, true>> queue_;
 };
 
 template <typename T, unsigned SIZE>
@@ -38,8 +54,12 @@ public:
         return true;
     }
 
+    bool try_push(const T& item) { return queue_.try_push(item); }
+
+    bool try_pop(T& item) { return queue_.try_pop(item); }
+
 private:
-    atomic_queue::RetryDecorator<atomic_queue::AtomicQueue<T, SIZE>> queue_;
+    atomic_queue::RetryDecorator<AtomicQueueFor<T, SIZE, true, true, false>> queue_;
 };
 
 template <typename T, unsigned SIZE>
@@ -57,8 +77,12 @@ public:
         return true;
     }
 
+    bool try_push(const T& item) { return queue_.try_push(item); }
+
+    bool try_pop(T& item) { return queue_.try_pop(item); }
+
 private:
-    atomic_queue::AtomicQueue<T, SIZE, T{}, false, false, false, true> queue_;
+    AtomicQueueFor<T, SIZE, false, false, true> queue_;
 };
 
 template <typename T, unsigned SIZE>
@@ -76,8 +100,35 @@ public:
         return true;
     }
 
+    bool try_push(const T& item) { return queue_.try_push(item); }
+
+    bool try_pop(T& item) { return queue_.try_pop(item); }
+
 private:
-    atomic_queue::AtomicQueue<T, SIZE> queue_;
+    AtomicQueueFor<T, SIZE, true, true, false> queue_;
 };
 
+template <typename T, unsigned SIZE>
+struct max_producers<AtomicQueueSPSCAdapter<T, SIZE>> : std::integral_constant<unsigned, 1> {};
+
+template <typename T, unsigned SIZE>
+struct max_consumers<AtomicQueueSPSCAdapter<T, SIZE>> : std::integral_constant<unsigned, 1> {};
+
+template <typename T, unsigned SIZE>
+struct max_producers<OptimistAtomicQueueSPSCAdapter<T, SIZE>>
+    : std::integral_constant<unsigned, 1> {};
+
+template <typename T, unsigned SIZE>
+struct max_consumers<OptimistAtomicQueueSPSCAdapter<T, SIZE>>
+    : std::integral_constant<unsigned, 1> {};
+
+static_assert(SpscQueue<AtomicQueueSPSCAdapter<int, 1024>>,
+              "AtomicQueueSPSCAdapter does not satisfy the SpscQueue concept");
+static_assert(ConcurrentQueue<AtomicQueueAdapter<int, 1024>>,
+              "AtomicQueueAdapter does not satisfy the ConcurrentQueue concept");
+static_assert(SpscQueue<OptimistAtomicQueueSPSCAdapter<int, 1024>>,
+              "OptimistAtomicQueueSPSCAdapter does not satisfy the SpscQueue concept");
+static_assert(ConcurrentQueue<OptimistAtomicQueueAdapter<int, 1024>>,
+              "OptimistAtomicQueueAdapter does not satisfy the ConcurrentQueue concept");
+
 #endif  // ATOMICQUEUEADAPTERS_H
@@ -0,0 +1,175 @@
+#ifndef AWAITABLEQUEUE_H
+#define AWAITABLEQUEUE_H
+
+#include <coroutine>
+#include <mutex>
+#include <utility>
+
+#include "CoroutineExecutors.h"
+#include "RingBuffer.h"
+
+/**
+ * @brief Bounded queue for coroutines
+ *
+ * co_await queue.pop() suspends the calling coroutine while the queue is empty, and
+ * co_await queue.push(item) while it is full, without blocking a thread. A suspended awaiter
+ * links itself into an intrusive waiter list, so waiting never allocates; the push or pop that
+ * satisfies it hands the item over directly and schedules the coroutine on the executor it was
+ * spawned on. try_push/try_pop let plain threads feed or drain the queue.
+ */
+template <typename T>
+class AwaitableQueue {
+    struct Waiter {
+        Waiter* next_ = nullptr;
+        std::coroutine_handle<> handle_;
+        Executor* executor_ = nullptr;
+        T item_{};
+
+        void resume() const { executor_->schedule(handle_); }
+    };
+
+    struct WaiterList {
+        Waiter* head_ = nullptr;
+        Waiter* tail_ = nullptr;
+
+        [[nodiscard]] bool empty() const { return head_ == nullptr; }
+
+        void push_back(Waiter* waiter) {
+            waiter->next_ = nullptr;
+            if (tail_)
+                tail_->next_ = waiter;
+            else
+                head_ = waiter;
+            tail_ = waiter;
+        }
+
+        Waiter* pop_front() {
+            Waiter* waiter = head_;
+            head_ = waiter->next_;
+            if (!head_) tail_ = nullptr;
+            return waiter;
+        }
+    };
+
+public:
+    using value_type = T;
+
+    class PopAwaiter : Waiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> handle) {
+            Waiter* unblocked = nullptr;
+            {
+                const std::lock_guard lock(queue_.mutex_);
+                if (!queue_.take_locked(this->item_, unblocked)) {
+                    this->handle_ = handle;
+                    this->executor_ = handle.promise().executor();
+                    queue_.pop_waiters_.push_back(this);
+                    return true;
+                }
+            }
+            if (unblocked) unblocked->resume();
+            return false;
+        }
+
+        T await_resume() { return std::move(this->item_); }
+
+    private:
+        friend class AwaitableQueue;
+        explicit PopAwaiter(AwaitableQueue& queue) : queue_(queue) {}
+
+        AwaitableQueue& queue_;
+    };
+
+    class PushAwaiter : Waiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> handle) {
+            Waiter* unblocked = nullptr;
+            {
+                const std::lock_guard lock(queue_.mutex_);
+                if (!queue_.put_locked(this->item_, unblocked)) {
+                    this->handle_ = handle;
+                    this->executor_ = handle.promise().executor();
+                    queue_.push_waiters_.push_back(this);
+                    return true;
+                }
+            }
+            if (unblocked) unblocked->resume();
+            return false;
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        friend class AwaitableQueue;
+        PushAwaiter(AwaitableQueue& queue, const T& item) : queue_(queue) { this->item_ = item; }
+
+        AwaitableQueue& queue_;
+    };
+
+    explicit AwaitableQueue(std::size_t capacity = 256) : buffer_(capacity) {}
+
+    AwaitableQueue(const AwaitableQueue&) = delete;
+    AwaitableQueue& operator=(const AwaitableQueue&) = delete;
+
+    [[nodiscard]] PopAwaiter pop() { return PopAwaiter{*this}; }
+    [[nodiscard]] PushAwaiter push(const T& item) { return PushAwaiter{*this, item}; }
+
+    bool try_push(const T& item) {
+        Waiter* unblocked = nullptr;
+        {
+            const std::lock_guard lock(mutex_);
+            if (!put_locked(item, unblocked)) return false;
+        }
+        if (unblocked) unblocked->resume();
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        Waiter* unblocked = nullptr;
+        {
+            const std::lock_guard lock(mutex_);
+            if (!take_locked(item, unblocked)) return false;
+        }
+        if (unblocked) unblocked->resume();
+        return true;
+    }
+
+private:
+    // Hands item to the oldest suspended pop, or buffers it. Returns false if the queue is full.
+    bool put_locked(const T& item, Waiter*& unblocked) {
+        if (!pop_waiters_.empty()) {
+            unblocked = pop_waiters_.pop_front();
+            unblocked->item_ = item;
+            return true;
+        }
+        if (buffer_.full()) return false;
+        buffer_.push_back(item);
+        return true;
+    }
+
+    // Takes the oldest item and refills its slot from the oldest suspended push. Returns false if
+    // the queue is empty.
+    bool take_locked(T& item, Waiter*& unblocked) {
+        if (buffer_.empty()) return false;
+        item = std::move(buffer_.front());
+        buffer_.pop_front();
+        if (!push_waiters_.empty()) {
+            unblocked = push_waiters_.pop_front();
+            buffer_.push_back(unblocked->item_);
+        }
+        return true;
+    }
+
+    std::mutex mutex_;
+    RingBuffer<T> buffer_;
+    WaiterList pop_waiters_;
+    WaiterList push_waiters_;
+};
+
+#endif  // AWAITABLEQUEUE_H
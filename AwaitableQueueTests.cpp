@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <latch>
+#include <vector>
+
+#include "AwaitableQueue.h"
+#include "CoroutineExecutors.h"
+
+class AwaitableQueueTest : public testing::Test {};
+
+TEST_F(AwaitableQueueTest, PopSuspendsUntilPushTest) {
+    SingleThreadExecutor executor;
+    AwaitableQueue<int> queue;
+    std::vector<int> popped;
+
+    spawn(executor, [](AwaitableQueue<int>& q, std::vector<int>& out) -> Task {
+        for (int i = 0; i < 3; ++i) out.push_back(co_await q.pop());
+    }(queue, popped));
+
+    executor.run_until_idle();
+    EXPECT_TRUE(popped.empty());
+
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    executor.run_until_idle();
+    EXPECT_EQ(popped, (std::vector<int>{1, 2}));
+
+    EXPECT_TRUE(queue.try_push(3));
+    executor.run_until_idle();
+    EXPECT_EQ(popped, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(AwaitableQueueTest, PushSuspendsWhileFullTest) {
+    SingleThreadExecutor executor;
+    AwaitableQueue<int> queue(2);
+    int pushed = 0;
+
+    spawn(executor, [](AwaitableQueue<int>& q, int& count) -> Task {
+        for (int i = 0; i < 4; ++i) {
+            co_await q.push(i);
+            ++count;
+        }
+    }(queue, pushed));
+
+    executor.run_until_idle();
+    EXPECT_EQ(pushed, 2);
+
+    int item = -1;
+    for (int expected = 0; expected < 4; ++expected) {
+        EXPECT_TRUE(queue.try_pop(item));
+        EXPECT_EQ(item, expected);
+        executor.run_until_idle();
+    }
+    EXPECT_EQ(pushed, 4);
+    EXPECT_FALSE(queue.try_pop(item));
+}
+
+TEST_F(AwaitableQueueTest, ThreadPoolPingPongTest) {
+    constexpr int kROUNDS = 10'000;
+    AwaitableQueue<int> ping(1);
+    AwaitableQueue<int> pong(1);
+    long long sum = 0;
+    std::latch done(2);
+    ThreadPoolExecutor executor(2);
+
+    spawn(executor, [](AwaitableQueue<int>& in, AwaitableQueue<int>& out,
+                       std::latch& finished) -> Task {
+        for (int i = 0; i < kROUNDS; ++i) co_await out.push(co_await in.pop() + 1);
+        finished.count_down();
+    }(ping, pong, done));
+
+    spawn(executor, [](AwaitableQueue<int>& out, AwaitableQueue<int>& in, long long& total,
+                       std::latch& finished) -> Task {
+        for (int i = 0; i < kROUNDS; ++i) {
+            co_await out.push(i);
+            total += co_await in.pop();
+        }
+        finished.count_down();
+    }(ping, pong, sum, done));
+
+    done.wait();
+    EXPECT_EQ(sum, static_cast<long long>(kROUNDS) * (kROUNDS + 1) / 2);
+}
@@ -0,0 +1,305 @@
+#ifndef BENCHMARKRESULTS_H
+#define BENCHMARKRESULTS_H
+
+#include <sys/utsname.h>
+
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "BenchmarkStats.h"
+#include "LatencyHistogram.h"
+
+#ifndef BENCHMARK_BUILD_FLAGS
+#define BENCHMARK_BUILD_FLAGS ""
+#endif
+
+// Where a set of results was produced, so runs from different machines or builds are not compared
+// by accident.
+struct MachineInfo {
+    std::string cpu_model;
+    std::string kernel;
+    std::string governor;
+    std::string compiler;
+    std::string build_flags;
+
+    static MachineInfo detect() {
+        MachineInfo info;
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        for (std::string line; std::getline(cpuinfo, line);) {
+            if (line.starts_with("model name")) {
+                info.cpu_model = line.substr(line.find(':') + 2);
+                break;
+            }
+        }
+        if (::utsname name; ::uname(&name) == 0)
+            info.kernel = std::string(name.sysname) + ' ' + name.release;
+        std::ifstream governor("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+        std::getline(governor, info.governor);
+#if defined(__clang__)
+        info.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+        info.compiler = "gcc " __VERSION__;
+#endif
+        info.build_flags = BENCHMARK_BUILD_FLAGS;
+        return info;
+    }
+};
+
+// One measured configuration: a queue, a topology and a payload, summarised over its runs.
+struct BenchmarkRecord {
+    std::string benchmark;  // e.g. "balanced", "single-producer", "payload", "latency"
+    std::string queue;
+    unsigned producers = 0;
+    unsigned consumers = 0;
+    std::size_t payload_bytes = 0;
+    std::size_t capacity = 0;  // 0 when the queue's type fixes it or the queue is unbounded
+    std::string metric = "throughput";  // or a latency percentile such as "p99"
+    std::string unit = "msg/s";
+    bool higher_is_better = true;
+    SampleSummary summary;
+
+    [[nodiscard]] std::string topology() const {
+        return std::to_string(producers) + "P/" + std::to_string(consumers) + "C";
+    }
+
+    // Identifies the same configuration across runs.
+    [[nodiscard]] std::string key() const {
+        return benchmark + '|' + queue + '|' + topology() + '|' + std::to_string(payload_bytes) +
+               '|' + metric;
+    }
+};
+
+// Percentiles recorded by add_percentiles(), as metric name and percentile.
+inline constexpr std::pair<char const*, double> kRECORDED_PERCENTILES[] = {
+    {"p50", 50}, {"p90", 90}, {"p99", 99}, {"p99.9", 99.9}, {"p99.99", 99.99}, {"max", 100}};
+
+/**
+ * @brief Collects BenchmarkRecords and writes them as JSON or CSV with the machine's metadata
+ *
+ * The CSV has one self-contained row per record (the machine columns repeat) so it can be loaded
+ * straight into a spreadsheet or dataframe, and read_csv() reads it back as a baseline for
+ * compare(). The JSON keeps the machine metadata once at the top.
+ */
+class BenchmarkResults {
+public:
+    void add(BenchmarkRecord record) { records_.push_back(std::move(record)); }
+
+    // One lower-is-better record in ns per entry of kRECORDED_PERCENTILES, with the rest of the
+    // fields taken from base. A histogram is a single measurement, so each record's interval is
+    // just its value and compare() relies on min_change to tell noise from a regression.
+    void add_percentiles(const BenchmarkRecord& base, const LatencyHistogram& histogram) {
+        for (const auto& [metric, percentile] : kRECORDED_PERCENTILES) {
+            BenchmarkRecord record = base;
+            record.metric = metric;
+            record.unit = "ns";
+            record.higher_is_better = false;
+            const auto value = static_cast<double>(histogram.percentile(percentile));
+            record.summary = SampleSummary{.count = histogram.count(),
+                                           .median = value,
+                                           .mean = value,
+                                           .min = value,
+                                           .max = value,
+                                           .ci_low = value,
+                                           .ci_high = value};
+            add(std::move(record));
+        }
+    }
+
+    [[nodiscard]] const std::vector<BenchmarkRecord>& records() const { return records_; }
+
+    void write_json(std::ostream& out, const MachineInfo& machine) const {
+        out << "{\n  \"machine\": {";
+        write_json_field(out, "cpu_model", machine.cpu_model, false);
+        write_json_field(out, "kernel", machine.kernel);
+        write_json_field(out, "governor", machine.governor);
+        write_json_field(out, "compiler", machine.compiler);
+        write_json_field(out, "build_flags", machine.build_flags);
+        out << "},\n  \"results\": [";
+        for (std::size_t i = 0; i < records_.size(); ++i) {
+            const auto& r = records_[i];
+            out << (i ? ",\n    {" : "\n    {");
+            write_json_field(out, "benchmark", r.benchmark, false);
+            write_json_field(out, "queue", r.queue);
+            write_json_field(out, "topology", r.topology());
+            out << ", \"producers\": " << r.producers << ", \"consumers\": " << r.consumers
+                << ", \"payload_bytes\": " << r.payload_bytes << ", \"capacity\": " << r.capacity;
+            write_json_field(out, "metric", r.metric);
+            write_json_field(out, "unit", r.unit);
+            out << ", \"higher_is_better\": " << (r.higher_is_better ? "true" : "false");
+            out << std::setprecision(17) << ", \"runs\": " << r.summary.count
+                << ", \"median\": " << r.summary.median << ", \"ci_low\": " << r.summary.ci_low
+                << ", \"ci_high\": " << r.summary.ci_high << ", \"mad\": " << r.summary.mad
+                << ", \"mean\": " << r.summary.mean << ", \"stddev\": " << r.summary.stddev
+                << ", \"min\": " << r.summary.min << ", \"max\": " << r.summary.max
+                << ", \"outliers\": " << r.summary.outliers.size() << '}';
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    void write_csv(std::ostream& out, const MachineInfo& machine) const {
+        out << "benchmark,queue,topology,producers,consumers,payload_bytes,capacity,metric,unit,"
+               "higher_is_better,runs,median,ci_low,ci_high,mad,mean,stddev,min,max,outliers,"
+               "cpu_model,kernel,governor,compiler,build_flags\n";
+        out << std::setprecision(17);
+        for (const auto& r : records_) {
+            out << csv_field(r.benchmark) << ',' << csv_field(r.queue) << ',' << r.topology()
+                << ',' << r.producers << ',' << r.consumers << ',' << r.payload_bytes << ','
+                << r.capacity << ',' << csv_field(r.metric) << ',' << csv_field(r.unit) << ','
+                << r.higher_is_better << ',' << r.summary.count << ','
+                << r.summary.median << ',' << r.summary.ci_low << ',' << r.summary.ci_high << ','
+                << r.summary.mad << ',' << r.summary.mean << ',' << r.summary.stddev << ','
+                << r.summary.min << ',' << r.summary.max << ',' << r.summary.outliers.size()
+                << ',' << csv_field(machine.cpu_model) << ',' << csv_field(machine.kernel) << ','
+                << csv_field(machine.governor) << ',' << csv_field(machine.compiler) << ','
+                << csv_field(machine.build_flags) << '\n';
+        }
+    }
+
+    // Reads rows written by write_csv(), finding columns by name. Outlier indices are not kept.
+    static std::vector<BenchmarkRecord> read_csv(std::istream& in) {
+        std::vector<BenchmarkRecord> records;
+        std::string line;
+        if (!std::getline(in, line)) return records;
+        std::map<std::string, std::size_t> column;
+        const auto header = split_csv(line);
+        for (std::size_t i = 0; i < header.size(); ++i) column[header[i]] = i;
+
+        while (std::getline(in, line)) {
+            if (line.empty()) continue;
+            const auto fields = split_csv(line);
+            const auto text = [&](const char* name) -> std::string {
+                const auto it = column.find(name);
+                return it != column.end() && it->second < fields.size() ? fields[it->second] : "";
+            };
+            const auto number = [&](const char* name) {
+                const auto value = text(name);
+                return value.empty() ? 0.0 : std::stod(value);
+            };
+
+            BenchmarkRecord r;
+            r.benchmark = text("benchmark");
+            r.queue = text("queue");
+            r.producers = static_cast<unsigned>(number("producers"));
+            r.consumers = static_cast<unsigned>(number("consumers"));
+            r.payload_bytes = static_cast<std::size_t>(number("payload_bytes"));
+            r.capacity = static_cast<std::size_t>(number("capacity"));
+            if (const auto metric = text("metric"); !metric.empty()) r.metric = metric;
+            r.unit = text("unit");
+            r.higher_is_better = text("higher_is_better") != "0";
+            r.summary.count = static_cast<std::size_t>(number("runs"));
+            r.summary.median = number("median");
+            r.summary.ci_low = number("ci_low");
+            r.summary.ci_high = number("ci_high");
+            r.summary.mad = number("mad");
+            r.summary.mean = number("mean");
+            r.summary.stddev = number("stddev");
+            r.summary.min = number("min");
+            r.summary.max = number("max");
+            records.push_back(std::move(r));
+        }
+        return records;
+    }
+
+    static std::vector<std::string> split_csv(const std::string_view line) {
+        std::vector<std::string> fields(1);
+        bool quoted = false;
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            const char c = line[i];
+            if (quoted) {
+                if (c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+                    fields.back() += line[++i];
+                else if (c == '"')
+                    quoted = false;
+                else
+                    fields.back() += c;
+            } else if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                fields.emplace_back();
+            } else if (c != '\r') {
+                fields.back() += c;
+            }
+        }
+        return fields;
+    }
+
+private:
+    static std::string csv_field(const std::string& value) {
+        if (value.find_first_of(",\"\n") == std::string::npos) return value;
+        std::string quoted = "\"";
+        for (const char c : value) quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+        return quoted + '"';
+    }
+
+    static void write_json_field(std::ostream& out, const char* name, const std::string& value,
+                                 const bool comma = true) {
+        out << (comma ? ", \"" : "\"") << name << "\": \"";
+        for (const char c : value) {
+            switch (c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+                            << std::dec << std::setfill(' ');
+                    else
+                        out << c;
+            }
+        }
+        out << '"';
+    }
+
+    std::vector<BenchmarkRecord> records_;
+};
+
+enum class Verdict { Regression, Improvement, Unchanged };
+
+struct Comparison {
+    BenchmarkRecord baseline;
+    BenchmarkRecord current;
+    double change;  // relative change of the median, e.g. -0.07 for 7% lower
+    Verdict verdict;
+};
+
+/**
+ * Pairs current records with baseline records of the same configuration and metric. A change only
+ * counts as a regression or an improvement when the two confidence intervals of the median do not
+ * overlap and the medians differ by more than min_change (a fraction): with few runs the intervals
+ * are narrow enough that disjoint ones alone would flag ordinary noise. Which direction is worse
+ * follows higher_is_better. Configurations missing from either side are skipped.
+ */
+inline std::vector<Comparison> compare(const std::vector<BenchmarkRecord>& baseline,
+                                       const std::vector<BenchmarkRecord>& current,
+                                       const double min_change = 0.0) {
+    std::map<std::string, const BenchmarkRecord*> by_key;
+    for (const auto& record : baseline) by_key[record.key()] = &record;
+
+    std::vector<Comparison> comparisons;
+    for (const auto& record : current) {
+        const auto it = by_key.find(record.key());
+        if (it == by_key.end()) continue;
+        const auto& before = *it->second;
+        const double change = before.summary.median != 0.0
+                                  ? record.summary.median / before.summary.median - 1.0
+                                  : 0.0;
+        Verdict verdict = Verdict::Unchanged;
+        if (record.summary.ci_high < before.summary.ci_low && -change > min_change)
+            verdict = record.higher_is_better ? Verdict::Regression : Verdict::Improvement;
+        else if (record.summary.ci_low > before.summary.ci_high && change > min_change)
+            verdict = record.higher_is_better ? Verdict::Improvement : Verdict::Regression;
+        comparisons.push_back({before, record, change, verdict});
+    }
+    return comparisons;
+}
+
+#endif  // BENCHMARKRESULTS_H
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BenchmarkResults.h"
+
+class BenchmarkResultsTest : public testing::Test {
+protected:
+    static BenchmarkRecord record(const std::string& queue, const double median,
+                                  const double ci_low, const double ci_high) {
+        BenchmarkRecord r;
+        r.benchmark = "balanced";
+        r.queue = queue;
+        r.producers = 2;
+        r.consumers = 2;
+        r.payload_bytes = 8;
+        r.capacity = 1024;
+        r.summary.count = 5;
+        r.summary.median = median;
+        r.summary.ci_low = ci_low;
+        r.summary.ci_high = ci_high;
+        return r;
+    }
+};
+
+TEST_F(BenchmarkResultsTest, CsvRoundTripsRecordsTest) {
+    BenchmarkResults results;
+    results.add(record("Queue<int, \"fast\", 1024>", 123456789.125, 123000000.5, 124000000.25));
+    results.add(record("plain", 1.0, 0.5, 1.5));
+    MachineInfo machine{"Some CPU @ 3.00GHz", "Linux 6.1", "performance", "gcc 13", "-O3, -g"};
+
+    std::stringstream csv;
+    results.write_csv(csv, machine);
+    const auto read = BenchmarkResults::read_csv(csv);
+
+    ASSERT_EQ(read.size(), 2);
+    EXPECT_EQ(read[0].queue, "Queue<int, \"fast\", 1024>");
+    EXPECT_EQ(read[0].topology(), "2P/2C");
+    EXPECT_EQ(read[0].payload_bytes, 8);
+    EXPECT_EQ(read[0].capacity, 1024);
+    EXPECT_EQ(read[0].unit, "msg/s");
+    EXPECT_EQ(read[0].summary.count, 5);
+    EXPECT_DOUBLE_EQ(read[0].summary.median, 123456789.125);
+    EXPECT_DOUBLE_EQ(read[0].summary.ci_high, 124000000.25);
+    EXPECT_EQ(read[0].key(), results.records()[0].key());
+    EXPECT_EQ(read[1].queue, "plain");
+
+    std::stringstream json;
+    results.write_json(json, machine);
+    EXPECT_NE(json.str().find(R"("queue": "Queue<int, \"fast\", 1024>")"), std::string::npos);
+    EXPECT_NE(json.str().find(R"("build_flags": "-O3, -g")"), std::string::npos);
+}
+
+TEST_F(BenchmarkResultsTest, OnlyNonOverlappingIntervalsAreFlaggedTest) {
+    const std::vector<BenchmarkRecord> baseline = {
+        record("slower", 100.0, 98.0, 102.0),
+        record("faster", 100.0, 98.0, 102.0),
+        record("noisy", 100.0, 98.0, 102.0),
+        record("removed", 100.0, 98.0, 102.0),
+    };
+    const std::vector<BenchmarkRecord> current = {
+        record("slower", 90.0, 89.0, 97.0),
+        record("faster", 110.0, 103.0, 111.0),
+        record("noisy", 95.0, 90.0, 99.0),
+        record("added", 100.0, 98.0, 102.0),
+    };
+
+    const auto comparisons = compare(baseline, current);
+    ASSERT_EQ(comparisons.size(), 3);
+    EXPECT_EQ(comparisons[0].verdict, Verdict::Regression);
+    EXPECT_DOUBLE_EQ(comparisons[0].change, -0.1);
+    EXPECT_EQ(comparisons[1].verdict, Verdict::Improvement);
+    EXPECT_EQ(comparisons[2].verdict, Verdict::Unchanged);
+
+    const auto thresholded = compare(baseline, current, 0.15);
+    EXPECT_EQ(thresholded[0].verdict, Verdict::Unchanged);
+    EXPECT_EQ(thresholded[1].verdict, Verdict::Unchanged);
+}
+
+TEST_F(BenchmarkResultsTest, LatencyPercentilesRegressUpwardsTest) {
+    LatencyHistogram before;
+    LatencyHistogram after;
+    for (std::uint64_t v = 1; v <= 1000; ++v) {
+        before.record(v);
+        after.record(v < 990 ? v : 10 * v);  // same median, far worse tail
+    }
+    const BenchmarkRecord base = record("queue", 0, 0, 0);
+    BenchmarkResults baseline;
+    baseline.add_percentiles(base, before);
+    BenchmarkResults current;
+    current.add_percentiles(base, after);
+
+    std::stringstream csv;
+    baseline.write_csv(csv, MachineInfo{});
+    const auto read = BenchmarkResults::read_csv(csv);
+    ASSERT_EQ(read.size(), std::size(kRECORDED_PERCENTILES));
+    EXPECT_EQ(read[0].metric, "p50");
+    EXPECT_EQ(read[0].unit, "ns");
+    EXPECT_FALSE(read[0].higher_is_better);
+
+    const auto comparisons = compare(read, current.records(), 0.02);
+    ASSERT_EQ(comparisons.size(), std::size(kRECORDED_PERCENTILES));
+    EXPECT_EQ(comparisons[0].current.metric, "p50");
+    EXPECT_EQ(comparisons[0].verdict, Verdict::Unchanged);
+    EXPECT_EQ(comparisons[2].current.metric, "p99");
+    EXPECT_EQ(comparisons[2].verdict, Verdict::Regression);
+    EXPECT_GT(comparisons[2].change, 0.0);
+}
@@ -0,0 +1,156 @@
+#ifndef BENCHMARKSTATS_H
+#define BENCHMARKSTATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Robust summary statistics and an adaptive repetition loop for benchmark samples
+ *
+ * Benchmark timings are skewed and prone to one-off spikes (page faults, frequency changes, a
+ * preempted thread), so the centre is the median, the spread is the median absolute deviation and
+ * the confidence interval of the median comes from a percentile bootstrap rather than a normal
+ * approximation. A sample is flagged as an outlier when its modified z-score,
+ * 0.6745 * |x - median| / MAD, exceeds outlier_z (3.5 per Iglewicz and Hoaglin); flagged samples
+ * are reported, not dropped.
+ */
+struct RunnerConfig {
+    unsigned warmup_runs = 1;  // discarded: page faults, allocator growth, frequency ramp-up
+    unsigned min_runs = 5;
+    unsigned max_runs = 30;
+    double target_ci = 0.01;   // stop once the CI half-width is within this fraction of the median
+    std::chrono::nanoseconds time_budget = std::chrono::seconds(120);  // per measured set
+    double confidence = 0.95;
+    unsigned bootstrap_resamples = 2000;
+    double outlier_z = 3.5;
+};
+
+struct SampleSummary {
+    std::size_t count = 0;
+    double median = 0.0;
+    double mad = 0.0;  // median absolute deviation, unscaled
+    double mean = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double ci_low = 0.0;  // bootstrap confidence interval of the median
+    double ci_high = 0.0;
+    std::vector<std::size_t> outliers;  // indices into the samples, in run order
+
+    // Half the CI width as a fraction of the median.
+    [[nodiscard]] double ci_half_width() const {
+        return median != 0.0 ? (ci_high - ci_low) / 2.0 / std::abs(median) : 0.0;
+    }
+};
+
+namespace stats {
+
+inline double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    const auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+    std::ranges::nth_element(values, middle);
+    if (values.size() % 2 == 1) return *middle;
+    return (*middle + *std::max_element(values.begin(), middle)) / 2.0;
+}
+
+// Value at fraction q of sorted, interpolating linearly between neighbours.
+inline double quantile_of_sorted(const std::vector<double>& sorted, const double q) {
+    if (sorted.empty()) return 0.0;
+    const double position = q * static_cast<double>(sorted.size() - 1);
+    const auto below = static_cast<std::size_t>(position);
+    const auto above = std::min(below + 1, sorted.size() - 1);
+    const double fraction = position - static_cast<double>(below);
+    return sorted[below] + (sorted[above] - sorted[below]) * fraction;
+}
+
+// Percentile bootstrap interval of the median. The seed is fixed so reruns over the same samples
+// report the same interval.
+inline std::pair<double, double> bootstrap_median_ci(const std::vector<double>& samples,
+                                                     const double confidence,
+                                                     const unsigned resamples) {
+    if (samples.size() < 2) {
+        const double only = samples.empty() ? 0.0 : samples.front();
+        return {only, only};
+    }
+    std::mt19937_64 rng(0x5EED);
+    std::uniform_int_distribution<std::size_t> pick(0, samples.size() - 1);
+    std::vector<double> resample(samples.size());
+    std::vector<double> medians;
+    medians.reserve(resamples);
+    for (unsigned r = 0; r < resamples; ++r) {
+        for (auto& value : resample) value = samples[pick(rng)];
+        medians.push_back(median(resample));
+    }
+    std::ranges::sort(medians);
+    const double tail = (1.0 - confidence) / 2.0;
+    return {quantile_of_sorted(medians, tail), quantile_of_sorted(medians, 1.0 - tail)};
+}
+
+inline SampleSummary summarize(const std::vector<double>& samples, const RunnerConfig& config) {
+    SampleSummary summary;
+    summary.count = samples.size();
+    if (samples.empty()) return summary;
+
+    summary.median = median(samples);
+    std::vector<double> deviations(samples.size());
+    std::ranges::transform(samples, deviations.begin(),
+                           [&](const double x) { return std::abs(x - summary.median); });
+    summary.mad = median(deviations);
+
+    const double n = static_cast<double>(samples.size());
+    summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    double squares = 0.0;
+    for (const double x : samples) squares += (x - summary.mean) * (x - summary.mean);
+    summary.stddev = samples.size() > 1 ? std::sqrt(squares / (n - 1.0)) : 0.0;
+    summary.min = std::ranges::min(samples);
+    summary.max = std::ranges::max(samples);
+
+    std::tie(summary.ci_low, summary.ci_high) =
+        bootstrap_median_ci(samples, config.confidence, config.bootstrap_resamples);
+
+    if (summary.mad > 0.0) {
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            if (0.6745 * deviations[i] / summary.mad > config.outlier_z)
+                summary.outliers.push_back(i);
+        }
+    }
+    return summary;
+}
+
+/**
+ * Calls run() config.warmup_runs times and ignores the results, then keeps calling it until the
+ * median's confidence interval is within config.target_ci, config.max_runs is reached, or
+ * config.time_budget has passed, but never fewer than config.min_runs times. run() returns one
+ * sample. on_warmup_done() runs between the two phases, e.g. to reset counters.
+ */
+template <typename Run, typename OnWarmupDone>
+SampleSummary run_until_stable(const RunnerConfig& config, Run&& run,
+                               OnWarmupDone&& on_warmup_done) {
+    for (unsigned i = 0; i < config.warmup_runs; ++i) run();
+    on_warmup_done();
+
+    const auto deadline = std::chrono::steady_clock::now() + config.time_budget;
+    std::vector<double> samples;
+    SampleSummary summary;
+    while (samples.size() < config.max_runs) {
+        samples.push_back(run());
+        if (samples.size() < config.min_runs) continue;
+        summary = summarize(samples, config);
+        if (summary.ci_half_width() <= config.target_ci) break;
+        if (std::chrono::steady_clock::now() >= deadline) break;
+    }
+    if (summary.count != samples.size()) summary = summarize(samples, config);
+    return summary;
+}
+
+}  // namespace stats
+
+#endif  // BENCHMARKSTATS_H
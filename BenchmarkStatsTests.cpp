@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "BenchmarkStats.h"
+
+class BenchmarkStatsTest : public testing::Test {};
+
+TEST_F(BenchmarkStatsTest, SummarizesAndFlagsOutliersTest) {
+    const std::vector<double> samples{12, 10, 100, 13, 11, 14};
+    const auto summary = stats::summarize(samples, RunnerConfig{});
+
+    EXPECT_EQ(summary.count, 6);
+    EXPECT_DOUBLE_EQ(summary.median, 12.5);
+    EXPECT_DOUBLE_EQ(summary.mad, 1.5);
+    EXPECT_NEAR(summary.mean, 160.0 / 6, 1e-9);
+    EXPECT_DOUBLE_EQ(summary.min, 10);
+    EXPECT_DOUBLE_EQ(summary.max, 100);
+    EXPECT_LE(summary.ci_low, summary.median);
+    EXPECT_GE(summary.ci_high, summary.median);
+    EXPECT_LT(summary.ci_high, 100);
+    EXPECT_EQ(summary.outliers, std::vector<std::size_t>{2});
+}
+
+TEST_F(BenchmarkStatsTest, RunsUntilIntervalIsNarrowTest) {
+    RunnerConfig config;
+    config.warmup_runs = 2;
+    config.min_runs = 5;
+    config.max_runs = 40;
+
+    unsigned calls = 0;
+    unsigned warmups_seen = 0;
+    const auto stable = stats::run_until_stable(
+        config, [&] { return ++calls <= 2 ? 1000.0 : 100.0; }, [&] { warmups_seen = calls; });
+    EXPECT_EQ(warmups_seen, 2);
+    EXPECT_EQ(stable.count, 5);
+    EXPECT_DOUBLE_EQ(stable.median, 100);
+    EXPECT_DOUBLE_EQ(stable.ci_half_width(), 0);
+
+    // Alternating samples never give a CI within 1%, so the run count caps it.
+    unsigned n = 0;
+    const auto noisy = stats::run_until_stable(
+        config, [&] { return ++n % 2 ? 50.0 : 150.0; }, [] {});
+    EXPECT_EQ(noisy.count, 40);
+
+    config.time_budget = std::chrono::nanoseconds(0);
+    const auto bounded = stats::run_until_stable(
+        config, [&] { return ++n % 2 ? 50.0 : 150.0; }, [] {});
+    EXPECT_EQ(bounded.count, config.min_runs);
+}
@@ -1,6 +1,8 @@
 #ifndef BOOSTLOCKFREEADAPTERS_H
 #define BOOSTLOCKFREEADAPTERS_H
 
+#include "ConcurrentQueueConcept.h"
+#include "QueueTypeTraits.h"
 #include "boost/lockfree/spsc_queue.hpp"
 #include "boost/lockfree/queue.hpp"
 
@@ -19,6 +21,10 @@ public:
         return true;
     }
 
+    bool try_push(const T& item) { return queue_.push(item); }
+
+    bool try_pop(T& item) { return queue_.pop(item); }
+
 private:
     boost::lockfree::spsc_queue<T, boost::lockfree::capacity<SIZE>> queue_;
 };
@@ -38,8 +44,23 @@ public:
         return true;
     }
 
+    bool try_push(const T& item) { return queue_.bounded_push(item); }
+
+    bool try_pop(T& item) { return queue_.pop(item); }
+
 private:
     boost::lockfree::queue<T, boost::lockfree::capacity<SIZE>> queue_;
 };
 
+template<typename T, std::size_t SIZE>
+struct max_producers<BoostLockFreeSPSCQueue<T, SIZE>> : std::integral_constant<unsigned, 1> {};
+
+template<typename T, std::size_t SIZE>
+struct max_consumers<BoostLockFreeSPSCQueue<T, SIZE>> : std::integral_constant<unsigned, 1> {};
+
+static_assert(SpscQueue<BoostLockFreeSPSCQueue<int, 1024>>,
+              "BoostLockFreeSPSCQueue does not satisfy the SpscQueue concept");
+static_assert(ConcurrentQueue<BoostLockFreeQueue<int, 1024>>,
+              "BoostLockFreeQueue does not satisfy the ConcurrentQueue concept");
+
 #endif //BOOSTLOCKFREEADAPTERS_H
@@ -0,0 +1,8 @@
+#ifndef CACHELINE_H
+#define CACHELINE_H
+
+#include <cstddef>
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+#endif  // CACHELINE_H
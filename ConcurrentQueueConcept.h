@@ -3,6 +3,8 @@
 
 #include <concepts>
 
+#include "QueueTypeTraits.h"
+
 /**
  * @brief Concurrent Queue concept
  *
@@ -11,6 +13,10 @@
  *  - try_push -> bool
  *  - pop -> bool
  *  - try_pop -> bool
+ *
+ * The mutex-based queues take their policies in one order: value type, lock (LockPolicy.h),
+ * notification (NotifyPolicy.h), then the overflow policy for bounded queues or the allocator
+ * for unbounded ones. The pmr:: aliases fix the allocator and keep the same leading parameters.
  */
 template<typename T>
 concept ConcurrentQueue = requires(T queue) {
@@ -20,4 +26,16 @@ concept ConcurrentQueue = requires(T queue) {
     { queue.try_pop(std::declval<typename T::value_type&>()) } -> std::same_as<bool>;
 };
 
+// Only safe with one producer thread and one consumer thread.
+template<typename T>
+concept SpscQueue = ConcurrentQueue<T> && max_producers_v<T> == 1 && max_consumers_v<T> == 1;
+
+// Also supports try_pop_bulk(out, max) -> number of items popped.
+template<typename T>
+concept BatchQueue = ConcurrentQueue<T> && supports_batch_v<T>;
+
+// pop() sleeps instead of spinning while the queue is empty.
+template<typename T>
+concept BlockingQueue = ConcurrentQueue<T> && is_blocking_v<T>;
+
 #endif //QUEUECONCEPT_H
@@ -2,28 +2,84 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <poll.h>
 #include <thread>
 
+#include "EventFdNotifier.h"
+#include "LockPolicy.h"
+#include "MichaelScottQueue.h"
 #include "MoodeyCamelQueueAdapters.h"
 #include "MutexBoostRingBufferQueue.h"
 #include "MutexDequeQueue.h"
+#include "MutexListQueue.h"
 #include "MutexRingBufferQueue.h"
+#include "NodePool.h"
+#include "NotifyPolicy.h"
+#include "QueueSelector.h"
+#include "SimdCopy.h"
+#include "StdAtomicMPMCQueue.h"
+#include "TwoLockQueue.h"
+#include "alpha_spsc.h"
 #include "random_num.h"
 
 using QueueTypes = testing::Types<
     MutexDequeQueue<int>,
+    MutexDequeQueue<int, AdaptiveMutex>,
+    MutexDequeQueue<int, std::mutex, BatchedNotify<8>>,
     MutexRingBufferQueue<int>,
+    MutexRingBufferQueue<int, AdaptiveMutex>,
+    MutexRingBufferQueue<int, std::mutex, BatchedNotify<8>>,
     MutexBoostRingBufferQueue<int>,
-    MoodyCamelBlockingQueue<int>
+    MutexBoostRingBufferQueue<int, BatchedNotify<8>>,
+    MoodyCamelBlockingQueue<int>,
+    MichaelScottQueue<int>,
+    PooledQueue<pmr::MutexDequeQueue<int>>,
+    PooledQueue<pmr::MutexListQueue<int>>,
+    TwoLockQueue<int>,
+    NotifyingQueue<MutexDequeQueue<int>>,
+    NotifyingQueue<MutexRingBufferQueue<int>>
 >;
 
 using BoundedQueueTypes = testing::Types<
     MutexRingBufferQueue<int>,
-    MutexBoostRingBufferQueue<int>
+    MutexRingBufferQueue<int, AdaptiveMutex>,
+    MutexRingBufferQueue<int, std::mutex, BatchedNotify<8>>,
+    MutexBoostRingBufferQueue<int>,
+    MutexBoostRingBufferQueue<int, BatchedNotify<8>>,
+    TwoLockQueue<int>,
+    NotifyingQueue<MutexRingBufferQueue<int>>
 >;
 
 using UnboundedQueueTypes = testing::Types<
-    MutexDequeQueue<int>
+    MutexDequeQueue<int>,
+    MutexDequeQueue<int, AdaptiveMutex>,
+    MutexDequeQueue<int, std::mutex, BatchedNotify<8>>,
+    MichaelScottQueue<int>,
+    PooledQueue<pmr::MutexDequeQueue<int>>,
+    PooledQueue<pmr::MutexListQueue<int>>,
+    TwoLockQueue<int>,
+    NotifyingQueue<MutexDequeQueue<int>>
+>;
+
+using BulkQueueTypes = testing::Types<
+    MutexDequeQueue<int>,
+    MutexListQueue<int>,
+    PooledQueue<pmr::MutexDequeQueue<int>>,
+    PooledQueue<pmr::MutexListQueue<int>>
+>;
+
+using DropNewestQueueTypes = testing::Types<
+    MutexRingBufferQueue<int, std::mutex, NotifyWaiters, OverflowPolicy::DropNewest>,
+    StdAtomicMPMCQueue<int, 4, OverflowPolicy::DropNewest>,
+    alpha::spsc<int, 4, 0, OverflowPolicy::DropNewest>
+>;
+
+using DropOldestQueueTypes = testing::Types<
+    MutexRingBufferQueue<int, std::mutex, NotifyWaiters, OverflowPolicy::DropOldest>,
+    StdAtomicMPMCQueue<int, 4, OverflowPolicy::DropOldest>,
+    alpha::spsc<int, 4, 0, OverflowPolicy::DropOldest>
 >;
 
 template <typename T>
@@ -41,6 +97,21 @@ class BoundedQueueTypedTest : public testing::Test {};
 
 TYPED_TEST_SUITE(BoundedQueueTypedTest, BoundedQueueTypes);
 
+template <typename T>
+class BulkQueueTypedTest : public testing::Test {};
+
+TYPED_TEST_SUITE(BulkQueueTypedTest, BulkQueueTypes);
+
+template <typename T>
+class DropNewestQueueTypedTest : public testing::Test {};
+
+TYPED_TEST_SUITE(DropNewestQueueTypedTest, DropNewestQueueTypes);
+
+template <typename T>
+class DropOldestQueueTypedTest : public testing::Test {};
+
+TYPED_TEST_SUITE(DropOldestQueueTypedTest, DropOldestQueueTypes);
+
 /**************************************************************
                         All Queue Types
 ***************************************************************/
@@ -169,6 +240,53 @@ TYPED_TEST(UnboundedQueueTypedTest, EnqueueTest) {
     EXPECT_EQ(total_sum, pushed_sum);
 }
 
+/******************************************************************
+                        Bulk Queue Types
+*******************************************************************/
+
+TYPED_TEST(BulkQueueTypedTest, pop_allTest) {
+    TypeParam queue;
+    const auto items = RandomNum::randomIntVec(1, 10000, 100);
+    for (const int n : items) queue.push(n);
+
+    std::vector<int> out;
+    EXPECT_EQ(queue.pop_all(out), items.size());
+    EXPECT_EQ(out, items);
+
+    int n = -1;
+    EXPECT_FALSE(queue.try_pop(n));
+}
+
+TYPED_TEST(BulkQueueTypedTest, pop_allBlocksTest) {
+    TypeParam queue;
+    std::atomic<std::size_t> popped = 0;
+
+    std::thread pop_thread([&] {
+        std::vector<int> out;
+        popped = queue.pop_all(out);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(popped, 0);
+
+    queue.push(7);
+    pop_thread.join();
+    EXPECT_EQ(popped, 1);
+}
+
+TYPED_TEST(BulkQueueTypedTest, try_pop_bulkTest) {
+    TypeParam queue;
+    std::vector<int> out;
+    EXPECT_EQ(queue.try_pop_bulk(std::back_inserter(out), 10), 0);
+
+    for (int i = 0; i < 25; ++i) queue.push(i);
+    EXPECT_EQ(queue.try_pop_bulk(std::back_inserter(out), 10), 10);
+    EXPECT_EQ(queue.try_pop_bulk(std::back_inserter(out), 100), 15);
+
+    std::vector<int> expected(25);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(out, expected);
+}
+
 /******************************************************************
                         Bounded Queue Types
 *******************************************************************/
@@ -202,3 +320,315 @@ TYPED_TEST(BoundedQueueTypedTest, pushTest) {
     EXPECT_TRUE(pushed);
 }
 
+/******************************************************************
+                        Notify Policies
+*******************************************************************/
+
+// Two consumers asleep in pop() and two quick pushes: the second push is not a transition and is
+// within the batch, so only the relay from the first woken consumer gets the other one going.
+// Repeated, since whether both pushes land before the woken consumer runs is up to the scheduler.
+template <typename Queue>
+void two_blocked_consumers_get_both_items() {
+    for (int round = 0; round < 200; ++round) {
+        Queue queue;
+        std::atomic<int> popped = 0;
+        const auto consume = [&] {
+            int n = -1;
+            queue.pop(n);
+            ++popped;
+        };
+        std::thread first(consume);
+        std::thread second(consume);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        queue.push(1);
+        queue.push(2);
+        first.join();
+        second.join();
+        EXPECT_EQ(popped, 2) << "round " << round;
+    }
+}
+
+// The same on the not-full side: two producers asleep in push() and two quick pops.
+template <typename Queue>
+void two_blocked_producers_get_both_slots() {
+    for (int round = 0; round < 200; ++round) {
+        Queue queue(2);
+        queue.push(0);
+        queue.push(0);
+        std::atomic<int> pushed = 0;
+        const auto produce = [&] {
+            queue.push(1);
+            ++pushed;
+        };
+        std::thread first(produce);
+        std::thread second(produce);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        int n = -1;
+        queue.pop(n);
+        queue.pop(n);
+        first.join();
+        second.join();
+        EXPECT_EQ(pushed, 2) << "round " << round;
+    }
+}
+
+using BatchedDequeQueue = MutexDequeQueue<int, std::mutex, BatchedNotify<8>>;
+using BatchedRingBufferQueue = MutexRingBufferQueue<int, std::mutex, BatchedNotify<8>>;
+using BatchedBoostRingBufferQueue = MutexBoostRingBufferQueue<int, BatchedNotify<8>>;
+
+TEST(BatchedNotifyTest, NoBlockedConsumerIsStrandedTest) {
+    two_blocked_consumers_get_both_items<BatchedDequeQueue>();
+    two_blocked_consumers_get_both_items<BatchedRingBufferQueue>();
+    two_blocked_consumers_get_both_items<BatchedBoostRingBufferQueue>();
+}
+
+TEST(BatchedNotifyTest, NoBlockedProducerIsStrandedTest) {
+    two_blocked_producers_get_both_slots<BatchedRingBufferQueue>();
+    two_blocked_producers_get_both_slots<BatchedBoostRingBufferQueue>();
+}
+
+/******************************************************************
+                        Overflow Policies
+*******************************************************************/
+
+// All overflow test queues hold 4 items.
+template <typename Queue>
+Queue make_overflow_queue() {
+    if constexpr (is_bounded_v<Queue>)
+        return Queue(4);
+    else
+        return Queue();
+}
+
+TYPED_TEST(DropNewestQueueTypedTest, DiscardsPushWhenFullTest) {
+    auto queue = make_overflow_queue<TypeParam>();
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.push(i));
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_FALSE(queue.push(5));
+    EXPECT_EQ(queue.dropped(), 2);
+
+    int out;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_pop(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_FALSE(queue.try_pop(out));
+}
+
+TYPED_TEST(DropOldestQueueTypedTest, OverwritesOldestWhenFullTest) {
+    auto queue = make_overflow_queue<TypeParam>();
+    for (int i = 0; i < 6; ++i) EXPECT_TRUE(queue.push(i));
+    EXPECT_FALSE(queue.try_push(6));
+    EXPECT_EQ(queue.dropped(), 2);
+
+    int out;
+    for (int i = 2; i < 6; ++i) {
+        EXPECT_TRUE(queue.try_pop(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_FALSE(queue.try_pop(out));
+}
+
+TYPED_TEST(DropOldestQueueTypedTest, ConcurrentOverloadTest) {
+    constexpr int kITEMS = 200'000;
+    auto queue = make_overflow_queue<TypeParam>();
+    std::atomic<bool> done = false;
+
+    std::thread producer([&] {
+        for (int i = 1; i <= kITEMS; ++i) queue.push(i);
+        done = true;
+    });
+
+    int received = 0;
+    int last = 0;
+    int out;
+    for (;;) {
+        const bool finished = done;
+        if (queue.try_pop(out)) {
+            EXPECT_GT(out, last);
+            last = out;
+            ++received;
+        } else if (finished) {
+            break;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(last, kITEMS);
+    EXPECT_EQ(received + static_cast<int>(queue.dropped()), kITEMS);
+}
+
+/******************************************************************
+                        Notifying Queue
+*******************************************************************/
+
+namespace {
+bool readable(const int fd) {
+    pollfd pfd{fd, POLLIN, 0};
+    return ::poll(&pfd, 1, 0) == 1;
+}
+}  // namespace
+
+TEST(NotifyingQueueTest, SignalsOnlyWhenEmptyTest) {
+    NotifyingQueue<MutexDequeQueue<int>> queue;
+    EXPECT_FALSE(readable(queue.fd()));
+
+    queue.push(1);
+    queue.push(2);
+    EXPECT_TRUE(readable(queue.fd()));
+    EXPECT_EQ(queue.notifications(), 1);
+
+    queue.acknowledge();
+    EXPECT_FALSE(readable(queue.fd()));
+
+    int out = -1;
+    EXPECT_TRUE(queue.try_pop(out));
+    queue.push(3);
+    EXPECT_FALSE(readable(queue.fd()));
+
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out, 3);
+    EXPECT_FALSE(queue.try_pop(out));
+
+    queue.push(4);
+    EXPECT_TRUE(readable(queue.fd()));
+    EXPECT_EQ(queue.notifications(), 2);
+}
+
+/******************************************************************
+                        Queue Selector
+*******************************************************************/
+
+TEST(QueueSelectorTest, VisitsOnlyReadyQueuesTest) {
+    QueueSelector<128> selector;
+    std::vector<std::unique_ptr<SelectableQueue<MutexDequeQueue<int>, 128>>> queues;
+    for (std::size_t i = 0; i < 128; ++i)
+        queues.push_back(std::make_unique<SelectableQueue<MutexDequeQueue<int>, 128>>(selector, i));
+
+    std::vector<std::size_t> visited;
+    EXPECT_EQ(selector.poll([&](std::size_t i) { visited.push_back(i); }), 0);
+
+    queues[3]->push(1);
+    queues[3]->push(2);
+    queues[100]->push(3);
+    EXPECT_EQ(selector.select([&](std::size_t i) { visited.push_back(i); }), 2);
+    EXPECT_EQ(visited, (std::vector<std::size_t>{3, 100}));
+
+    int out;
+    while (queues[3]->try_pop(out)) {}
+    queues[3]->push(4);
+    visited.clear();
+    EXPECT_EQ(selector.poll([&](std::size_t i) { visited.push_back(i); }), 1);
+    EXPECT_EQ(visited, (std::vector<std::size_t>{3}));
+}
+
+TEST(QueueSelectorTest, FanInSumTest) {
+    constexpr std::size_t kPRODUCERS = 16;
+    constexpr int kITEMS = 10'000;
+    using Inbox = SelectableQueue<alpha::spsc<int, 256, 0>>;
+
+    QueueSelector<> selector;
+    std::vector<std::unique_ptr<Inbox>> inboxes;
+    for (std::size_t i = 0; i < kPRODUCERS; ++i)
+        inboxes.push_back(std::make_unique<Inbox>(selector, i));
+
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < kPRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (int n = 1; n <= kITEMS; ++n) inboxes[p]->push(n);
+        });
+    }
+
+    long long sum = 0;
+    std::size_t received = 0;
+    while (received < kPRODUCERS * kITEMS) {
+        selector.select([&](const std::size_t i) {
+            int item;
+            while (inboxes[i]->try_pop(item)) {
+                sum += item;
+                ++received;
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+    EXPECT_EQ(sum, static_cast<long long>(kPRODUCERS) * kITEMS * (kITEMS + 1) / 2);
+}
+
+TEST(QueueSelectorTest, DroppedPushIsReportedTest) {
+    using Inbox = SelectableQueue<
+        MutexRingBufferQueue<int, std::mutex, NotifyWaiters, OverflowPolicy::DropNewest>>;
+    static_assert(is_bounded_v<Inbox> && is_lossy_v<Inbox>);
+
+    QueueSelector<> selector;
+    Inbox inbox(selector, 7, 4);
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(inbox.push(i));
+    EXPECT_FALSE(inbox.push(4));
+    EXPECT_EQ(inbox.dropped(), 1);
+
+    std::vector<std::size_t> visited;
+    EXPECT_EQ(selector.poll([&](std::size_t i) { visited.push_back(i); }), 1);
+    EXPECT_EQ(visited, (std::vector<std::size_t>{7}));
+    int out;
+    int received = 0;
+    while (inbox.try_pop(out)) EXPECT_EQ(out, received++);
+    EXPECT_EQ(received, 4);
+}
+
+/******************************************************************
+                        SIMD Bulk Copy
+*******************************************************************/
+
+TEST(SimdBulkCopyTest, PathsCopyExactlyTheRequestedBytesTest) {
+    // Never 0, so any byte written outside the destination range shows up.
+    std::vector<std::uint8_t> src(600);
+    for (std::size_t i = 0; i < src.size(); ++i) src[i] = static_cast<std::uint8_t>(i % 255 + 1);
+    for (const auto copy : {simd::copy_scalar, simd::copy_sse2, simd::copy_avx2}) {
+        for (const auto hint : {simd::StoreHint::Cached, simd::StoreHint::NonTemporal}) {
+            for (std::size_t bytes = 0; bytes < 300; ++bytes) {
+                for (std::size_t offset = 0; offset < 4; ++offset) {
+                    std::vector<std::uint8_t> dst(bytes + 8, 0);
+                    copy(dst.data() + offset, src.data() + 3, bytes, hint);
+                    ASSERT_TRUE(std::equal(src.begin() + 3, src.begin() + 3 + bytes,
+                                           dst.begin() + offset));
+                    ASSERT_EQ(std::count(dst.begin(), dst.end(), 0), 8);
+                }
+            }
+        }
+    }
+}
+
+TEST(SimdBulkCopyTest, AlphaBulkPushPopWrapsTest) {
+    alpha::spsc<std::uint32_t, 100, 0> queue;
+    std::vector<std::uint32_t> items(150);
+    std::iota(items.begin(), items.end(), 0u);
+    std::vector<std::uint32_t> out(160);
+
+    EXPECT_EQ(queue.try_push_bulk(items.data(), 70), 70);
+    EXPECT_EQ(queue.try_pop_bulk(out.data(), 60), 60);
+    // Tail is at 70 of 100, so this batch wraps; only 90 slots are free.
+    EXPECT_EQ(queue.try_push_bulk(items.data() + 70, 80), 80);
+    EXPECT_EQ(queue.try_push_bulk(items.data(), 50), 10);
+    EXPECT_EQ(queue.try_pop_bulk(out.data() + 60, 200), 100);
+    EXPECT_TRUE(std::equal(items.begin(), items.end(), out.begin()));
+    EXPECT_TRUE(std::equal(items.begin(), items.begin() + 10, out.begin() + 150));
+    std::uint32_t n;
+    EXPECT_FALSE(queue.try_pop(n));
+}
+
+TEST(SimdBulkCopyTest, MutexRingBufferBulkPushPopWrapsTest) {
+    MutexRingBufferQueue<std::uint64_t> queue(10);
+    const std::vector<std::uint64_t> items{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::vector<std::uint64_t> out(12);
+
+    EXPECT_EQ(queue.try_push_bulk(items.data(), 7), 7);
+    EXPECT_EQ(queue.try_pop_bulk(out.data(), 5), 5);
+    EXPECT_EQ(queue.try_push_bulk(items.data() + 7, 5), 5);
+    EXPECT_EQ(queue.try_push_bulk(items.data(), 12), 3);
+    EXPECT_EQ(queue.try_pop_bulk(out.data() + 5, 7), 7);
+    EXPECT_TRUE(std::equal(items.begin(), items.end(), out.begin()));
+    std::uint64_t n = 0;
+    EXPECT_TRUE(queue.try_pop(n));
+    EXPECT_EQ(n, 1u);
+}
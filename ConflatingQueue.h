@@ -0,0 +1,179 @@
+#ifndef CONFLATINGQUEUE_H
+#define CONFLATINGQUEUE_H
+
+#include <emmintrin.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+
+#include "CacheLine.h"
+#include "ConcurrentQueueConcept.h"
+#include "NodePool.h"
+#include "QueueTypeTraits.h"
+
+/**
+ * @brief Multi-producer, single-consumer queue that merges updates to a key while it is queued
+ *
+ * Pushing a key that is still waiting to be popped overwrites its pending value in place, so the
+ * consumer only ever sees the newest value for a key and the key keeps its place in FIFO order,
+ * which is the order of first enqueue. Keys not yet queued are appended to an intrusive Vyukov
+ * MPSC list.
+ *
+ * The key -> pending node index is split into STRIPES maps, each behind its own mutex, so
+ * producers only contend when their keys hash to the same stripe. pop() takes the node off the
+ * list without a lock and then locks its stripe to unindex it and read the value, which is what
+ * keeps an update from landing in a node that is already gone. Nodes and map entries come from a
+ * NodePoolResource, so steady-state traffic does not touch the global allocator.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          std::size_t STRIPES = 64>
+class ConflatingQueue {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+
+    ConflatingQueue() : stripes_(make_stripes(&pool_, std::make_index_sequence<STRIPES>{})) {}
+
+    ConflatingQueue(const ConflatingQueue&) = delete;
+    ConflatingQueue& operator=(const ConflatingQueue&) = delete;
+
+    ~ConflatingQueue() {
+        Node* node = tail_;
+        while (node) {
+            Node* next = node->next_.load(std::memory_order::relaxed);
+            if (node != &stub_) destroy(node);
+            node = next;
+        }
+    }
+
+    bool push(const value_type& item) { return push(item.first, item.second); }
+
+    bool push(const Key& key, const Value& value) {
+        auto& stripe = stripe_for(key);
+        const std::lock_guard lock(stripe.mutex_);
+        if (const auto it = stripe.pending_.find(key); it != stripe.pending_.end()) {
+            it->second->item_.second = value;
+            conflated_.fetch_add(1, std::memory_order::relaxed);
+            return true;
+        }
+        Node* node = create(key, value);
+        stripe.pending_.emplace(key, node);
+        enqueue(node);
+        return true;
+    }
+
+    bool try_push(const value_type& item) { return push(item); }
+
+    bool pop(value_type& item) {
+        while (!try_pop(item)) _mm_pause();
+        return true;
+    }
+
+    // Consumer only. May briefly report empty while a producer is between its two enqueue steps.
+    bool try_pop(value_type& item) {
+        Node* node = dequeue();
+        if (!node) return false;
+        {
+            auto& stripe = stripe_for(node->item_.first);
+            const std::lock_guard lock(stripe.mutex_);
+            stripe.pending_.erase(node->item_.first);
+            item = std::move(node->item_);
+        }
+        destroy(node);
+        return true;
+    }
+
+    // Pushes absorbed by a pending entry instead of enqueuing a new one.
+    [[nodiscard]] std::uint64_t conflated() const {
+        return conflated_.load(std::memory_order::relaxed);
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next_{nullptr};
+        value_type item_;
+    };
+
+    using Index = std::pmr::unordered_map<Key, Node*, Hash>;
+
+    struct alignas(CACHE_LINE_SIZE) Stripe {
+        explicit Stripe(std::pmr::memory_resource* resource) : pending_(resource) {}
+
+        std::mutex mutex_;
+        Index pending_;
+    };
+
+    template <std::size_t... I>
+    static std::array<Stripe, STRIPES> make_stripes(std::pmr::memory_resource* resource,
+                                                    std::index_sequence<I...>) {
+        return {{((void)I, Stripe(resource))...}};
+    }
+
+    Stripe& stripe_for(const Key& key) { return stripes_[Hash{}(key) % STRIPES]; }
+
+    Node* create(const Key& key, const Value& value) {
+        void* memory = pool_.allocate(sizeof(Node), alignof(Node));
+        return ::new (memory) Node{nullptr, value_type(key, value)};
+    }
+
+    void destroy(Node* node) {
+        node->~Node();
+        pool_.deallocate(node, sizeof(Node), alignof(Node));
+    }
+
+    void enqueue(Node* node) {
+        node->next_.store(nullptr, std::memory_order::relaxed);
+        Node* prev = head_.exchange(node, std::memory_order::acq_rel);
+        prev->next_.store(node, std::memory_order::release);
+    }
+
+    Node* dequeue() {
+        Node* tail = tail_;
+        Node* next = tail->next_.load(std::memory_order::acquire);
+        if (tail == &stub_) {
+            if (!next) return nullptr;
+            tail_ = next;
+            tail = next;
+            next = next->next_.load(std::memory_order::acquire);
+        }
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order::acquire)) return nullptr;
+        enqueue(&stub_);
+        next = tail->next_.load(std::memory_order::acquire);
+        if (!next) return nullptr;
+        tail_ = next;
+        return tail;
+    }
+
+    NodePoolResource pool_;
+    std::array<Stripe, STRIPES> stripes_;
+    Node stub_;
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> head_{&stub_};
+    std::atomic<std::uint64_t> conflated_{0};
+    alignas(CACHE_LINE_SIZE) Node* tail_ = &stub_;
+};
+
+// Single consumer, and a push to a queued key replaces the value already waiting.
+template <typename Key, typename Value, typename Hash, std::size_t STRIPES>
+struct max_consumers<ConflatingQueue<Key, Value, Hash, STRIPES>>
+    : std::integral_constant<unsigned, 1> {};
+
+template <typename Key, typename Value, typename Hash, std::size_t STRIPES>
+struct is_lossy<ConflatingQueue<Key, Value, Hash, STRIPES>> : std::true_type {};
+
+static_assert(ConcurrentQueue<ConflatingQueue<int, int>>,
+              "ConflatingQueue does not satisfy the ConcurrentQueue concept");
+
+#endif  // CONFLATINGQUEUE_H
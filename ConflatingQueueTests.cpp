@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ConflatingQueue.h"
+
+class ConflatingQueueTest : public testing::Test {};
+
+TEST_F(ConflatingQueueTest, MergesPendingKeysInFirstEnqueueOrderTest) {
+    ConflatingQueue<std::string, int> queue;
+    queue.push("a", 1);
+    queue.push("b", 1);
+    queue.push("a", 2);
+    queue.push("c", 1);
+    queue.push("b", 2);
+    queue.push("a", 3);
+    EXPECT_EQ(queue.conflated(), 3);
+
+    std::pair<std::string, int> item;
+    ASSERT_TRUE(queue.try_pop(item));
+    EXPECT_EQ(item, std::make_pair(std::string("a"), 3));
+    ASSERT_TRUE(queue.try_pop(item));
+    EXPECT_EQ(item, std::make_pair(std::string("b"), 2));
+
+    // a was popped, so a new update goes to the back instead of being merged.
+    queue.push("a", 4);
+    ASSERT_TRUE(queue.try_pop(item));
+    EXPECT_EQ(item, std::make_pair(std::string("c"), 1));
+    ASSERT_TRUE(queue.try_pop(item));
+    EXPECT_EQ(item, std::make_pair(std::string("a"), 4));
+    EXPECT_FALSE(queue.try_pop(item));
+    EXPECT_EQ(queue.conflated(), 3);
+}
+
+TEST_F(ConflatingQueueTest, ConcurrentProducersDeliverLatestValuePerKeyTest) {
+    constexpr unsigned kPRODUCERS = 4;
+    constexpr unsigned kKEYS_PER_PRODUCER = 32;
+    constexpr std::uint64_t kUPDATES = 100'000;
+    ConflatingQueue<unsigned, std::uint64_t> queue;
+
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < kPRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (std::uint64_t n = 1; n <= kUPDATES; ++n)
+                queue.push(p * kKEYS_PER_PRODUCER + n % kKEYS_PER_PRODUCER, n);
+        });
+    }
+
+    // Each key's values must arrive strictly increasing and end with its last update.
+    std::vector<std::uint64_t> last(kPRODUCERS * kKEYS_PER_PRODUCER, 0);
+    std::uint64_t popped = 0;
+    int out_of_order = 0;
+    auto drain = [&] {
+        std::pair<unsigned, std::uint64_t> item;
+        while (queue.try_pop(item)) {
+            if (item.second <= last[item.first]) ++out_of_order;
+            last[item.first] = item.second;
+            ++popped;
+        }
+    };
+    while (popped + queue.conflated() < kPRODUCERS * kUPDATES) drain();
+    for (auto& t : producers) t.join();
+    drain();
+
+    EXPECT_EQ(out_of_order, 0);
+    EXPECT_EQ(popped + queue.conflated(), kPRODUCERS * kUPDATES);
+    for (unsigned key = 0; key < last.size(); ++key)
+        EXPECT_EQ(last[key] % kKEYS_PER_PRODUCER, key % kKEYS_PER_PRODUCER);
+    for (unsigned key = 0; key < last.size(); ++key)
+        EXPECT_GT(last[key], kUPDATES - kKEYS_PER_PRODUCER);
+}
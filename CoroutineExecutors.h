@@ -0,0 +1,120 @@
+#ifndef COROUTINEEXECUTORS_H
+#define COROUTINEEXECUTORS_H
+
+#include <coroutine>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "MutexDequeQueue.h"
+
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual void schedule(std::coroutine_handle<> handle) = 0;
+};
+
+/**
+ * @brief Fire-and-forget coroutine
+ *
+ * Starts suspended and does nothing until handed to spawn(), which binds it to an executor and
+ * schedules its first resumption. The frame destroys itself when the coroutine finishes.
+ */
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object() {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        [[nodiscard]] Executor* executor() const { return executor_; }
+
+        Executor* executor_ = nullptr;
+    };
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task& operator=(Task&&) = delete;
+
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+    friend void spawn(Executor& executor, Task task) {
+        auto handle = std::exchange(task.handle_, {});
+        handle.promise().executor_ = &executor;
+        executor.schedule(handle);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Runs every scheduled coroutine on the thread that calls run() or run_until_idle().
+class SingleThreadExecutor : public Executor {
+public:
+    void schedule(std::coroutine_handle<> handle) override { ready_.push(handle); }
+
+    // Resumes coroutines until stop() is called.
+    void run() {
+        std::coroutine_handle<> handle;
+        for (;;) {
+            ready_.pop(handle);
+            if (!handle) return;
+            handle.resume();
+        }
+    }
+
+    // Resumes coroutines until none is ready to run.
+    void run_until_idle() {
+        std::coroutine_handle<> handle;
+        while (ready_.try_pop(handle) && handle) handle.resume();
+    }
+
+    void stop() { ready_.push(nullptr); }
+
+private:
+    MutexDequeQueue<std::coroutine_handle<>> ready_;
+};
+
+// Resumes scheduled coroutines on a fixed set of worker threads sharing one ready queue.
+class ThreadPoolExecutor : public Executor {
+public:
+    explicit ThreadPoolExecutor(const unsigned thread_count) {
+        workers_.reserve(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i) {
+            workers_.emplace_back([this] {
+                std::coroutine_handle<> handle;
+                for (;;) {
+                    ready_.pop(handle);
+                    if (!handle) return;
+                    handle.resume();
+                }
+            });
+        }
+    }
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    ~ThreadPoolExecutor() override {
+        for (std::size_t i = 0; i < workers_.size(); ++i) ready_.push(nullptr);
+        for (auto& worker : workers_) worker.join();
+    }
+
+    void schedule(std::coroutine_handle<> handle) override { ready_.push(handle); }
+
+private:
+    MutexDequeQueue<std::coroutine_handle<>> ready_;
+    std::vector<std::thread> workers_;
+};
+
+#endif  // COROUTINEEXECUTORS_H
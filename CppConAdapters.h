@@ -1,5 +1,6 @@
 
 #include <emmintrin.h>
+#include "QueueTypeTraits.h"
 #include "cppcon2023/Fifo1.hpp"
 #include "cppcon2023/Fifo2.hpp"
 #include "cppcon2023/Fifo3.hpp"
@@ -7,22 +8,32 @@
 
 template <typename Queue, std::size_t SIZE>
 struct FifoAdapter : Queue {
-    using T = Queue::value_type;
+    using value_type = Queue::value_type;
+    using T = value_type;
 
     explicit FifoAdapter() : Queue(SIZE){};
 
 
-    void push(const T& element) {
+    bool push(const T& element) {
         while (!this->try_push(element))
             _mm_pause();
+        return true;
     }
 
-    void pop(T& element) {
+    bool pop(T& element) {
         while (!this->try_pop(element))
             _mm_pause();
+        return true;
     }
 };
 
+// Every Fifo is a single-producer, single-consumer ring.
+template <typename Queue, std::size_t SIZE>
+struct max_producers<FifoAdapter<Queue, SIZE>> : std::integral_constant<unsigned, 1> {};
+
+template <typename Queue, std::size_t SIZE>
+struct max_consumers<FifoAdapter<Queue, SIZE>> : std::integral_constant<unsigned, 1> {};
+
 template<typename T, std::size_t SIZE>
 using fifo1_adapter = FifoAdapter<Fifo1<T>, SIZE>;
 
@@ -0,0 +1,179 @@
+#ifndef CPUTOPOLOGY_H
+#define CPUTOPOLOGY_H
+
+#include <sched.h>
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// Where the two threads of a producer/consumer pair run relative to each other.
+enum class Placement {
+    SmtSiblings,      // two hardware threads of one physical core
+    SameL3,           // different cores sharing a last-level cache (one CCX on AMD)
+    DifferentL3,      // same socket, different last-level caches
+    DifferentSocket,  // different packages, so every transfer crosses the interconnect
+    Unpinned,         // wherever the scheduler puts them
+};
+
+inline constexpr Placement kALL_PLACEMENTS[] = {Placement::SmtSiblings, Placement::SameL3,
+                                                Placement::DifferentL3, Placement::DifferentSocket,
+                                                Placement::Unpinned};
+
+inline char const* placement_name(const Placement placement) {
+    switch (placement) {
+        case Placement::SmtSiblings: return "SMT siblings";
+        case Placement::SameL3: return "same L3";
+        case Placement::DifferentL3: return "different L3";
+        case Placement::DifferentSocket: return "different socket";
+        case Placement::Unpinned: return "unpinned";
+    }
+    return "?";
+}
+
+// A pair of logical CPUs for pinThread(); -1 leaves that thread unpinned.
+struct CpuPair {
+    int first = -1;
+    int second = -1;
+};
+
+struct CpuInfo {
+    int cpu;
+    int core;     // core_id, unique within a package
+    int package;  // physical_package_id
+    int l3;       // lowest CPU sharing this CPU's L3, or -1 when the kernel doesn't say
+};
+
+// Parses a sysfs CPU list such as "0-3,8,10-11".
+inline std::vector<int> parse_cpu_list(std::string_view list) {
+    std::vector<int> cpus;
+    while (!list.empty()) {
+        const auto comma = list.find(',');
+        const auto range = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        const char* const range_end = range.data() + range.size();
+        int first = 0;
+        const auto [end, error] = std::from_chars(range.data(), range_end, first);
+        if (error != std::errc{}) continue;
+        int last = first;
+        if (end != range_end && *end == '-') std::from_chars(end + 1, range_end, last);
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+// Logical CPUs in the calling thread's affinity mask, lowest first; empty if it can't be read.
+inline std::vector<int> allowed_cpus() {
+    ::cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    std::vector<int> cpus;
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+    return cpus;
+}
+
+/**
+ * @brief Logical CPUs this process may run on, grouped by core, L3 and package from sysfs
+ *
+ * Read from /sys/devices/system/cpu/cpuN/topology and cpuN/cache/indexK. detect() leaves out
+ * CPUs outside the process's affinity mask, so pair() only hands out CPUs pinThread() can use.
+ * Anything sysfs does not describe (containers often hide the cache directories) just makes the
+ * placements that depend on it unavailable rather than guessed.
+ */
+class CpuTopology {
+public:
+    explicit CpuTopology(std::vector<CpuInfo> cpus) : cpus_(std::move(cpus)) {}
+
+    // The CPUs of this machine that the calling process is allowed to run on.
+    static CpuTopology detect() {
+        auto topology = read("/sys/devices/system/cpu");
+        if (const auto allowed = allowed_cpus(); !allowed.empty()) {
+            std::erase_if(topology.cpus_, [&](const CpuInfo& info) {
+                return !std::ranges::binary_search(allowed, info.cpu);
+            });
+        }
+        return topology;
+    }
+
+    // Every online CPU described under root, which has the layout of /sys/devices/system/cpu.
+    static CpuTopology read(const std::filesystem::path& root) {
+        std::vector<CpuInfo> cpus;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(root, error)) {
+            const auto name = entry.path().filename().string();
+            int cpu = -1;
+            if (!name.starts_with("cpu") ||
+                std::from_chars(name.data() + 3, name.data() + name.size(), cpu).ptr !=
+                    name.data() + name.size())
+                continue;
+
+            const auto core = read_int(entry.path() / "topology/core_id");
+            const auto package = read_int(entry.path() / "topology/physical_package_id");
+            if (!core || !package) continue;  // offline CPUs have no topology directory
+            cpus.push_back({cpu, *core, *package, l3_of(entry.path())});
+        }
+        std::ranges::sort(cpus, {}, &CpuInfo::cpu);
+        return CpuTopology(std::move(cpus));
+    }
+
+    [[nodiscard]] const std::vector<CpuInfo>& cpus() const { return cpus_; }
+
+    // The lowest-numbered pair of CPUs in the given placement, if the machine has one.
+    [[nodiscard]] std::optional<CpuPair> pair(const Placement placement) const {
+        if (placement == Placement::Unpinned) return CpuPair{};
+        for (const auto& a : cpus_) {
+            for (const auto& b : cpus_) {
+                if (b.cpu > a.cpu && matches(placement, a, b)) return CpuPair{a.cpu, b.cpu};
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    static bool matches(const Placement placement, const CpuInfo& a, const CpuInfo& b) {
+        const bool same_package = a.package == b.package;
+        const bool same_core = same_package && a.core == b.core;
+        const bool l3_known = a.l3 >= 0 && b.l3 >= 0;
+        switch (placement) {
+            case Placement::SmtSiblings: return same_core;
+            case Placement::SameL3: return !same_core && l3_known && a.l3 == b.l3;
+            case Placement::DifferentL3: return same_package && l3_known && a.l3 != b.l3;
+            case Placement::DifferentSocket: return !same_package;
+            case Placement::Unpinned: return true;
+        }
+        return false;
+    }
+
+    static std::optional<int> read_int(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        int value;
+        if (file >> value) return value;
+        return std::nullopt;
+    }
+
+    static int l3_of(const std::filesystem::path& cpu_dir) {
+        std::error_code error;
+        for (const auto& index : std::filesystem::directory_iterator(cpu_dir / "cache", error)) {
+            if (read_int(index.path() / "level") != 3) continue;
+            std::ifstream file(index.path() / "shared_cpu_list");
+            std::string list;
+            if (!std::getline(file, list)) continue;
+            const auto shared = parse_cpu_list(list);
+            if (!shared.empty()) return std::ranges::min(shared);
+        }
+        return -1;
+    }
+
+    std::vector<CpuInfo> cpus_;
+};
+
+#endif  // CPUTOPOLOGY_H
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "CpuTopology.h"
+
+namespace fs = std::filesystem;
+
+class CpuTopologyTest : public testing::Test {
+protected:
+    void SetUp() override {
+        root_ = fs::path(testing::TempDir()) / "cpu_topology_test";
+        fs::remove_all(root_);
+        fs::create_directories(root_ / "cpufreq");
+        fs::create_directories(root_ / "cpu12");  // offline: no topology directory
+    }
+
+    void TearDown() override { fs::remove_all(root_); }
+
+    // l3_list is the cpu's L3 shared_cpu_list, or empty to describe no L3 at all.
+    void add_cpu(const int cpu, const int package, const int core, const std::string& l3_list) {
+        const auto dir = root_ / ("cpu" + std::to_string(cpu));
+        write(dir / "topology/core_id", std::to_string(core));
+        write(dir / "topology/physical_package_id", std::to_string(package));
+        write(dir / "cache/index0/level", "1");
+        write(dir / "cache/index0/shared_cpu_list", std::to_string(cpu));
+        if (!l3_list.empty()) {
+            write(dir / "cache/index3/level", "3");
+            write(dir / "cache/index3/shared_cpu_list", l3_list);
+        }
+    }
+
+    static void write(const fs::path& path, const std::string& text) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << text << '\n';
+    }
+
+    fs::path root_;
+};
+
+TEST_F(CpuTopologyTest, ParsesCpuListsTest) {
+    EXPECT_EQ(parse_cpu_list("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parse_cpu_list("5"), std::vector<int>{5});
+    EXPECT_TRUE(parse_cpu_list("").empty());
+}
+
+TEST_F(CpuTopologyTest, FindsPairForEachPlacementTest) {
+    // Socket 0 has two L3 domains (cpus 0-3 and 4-7), socket 1 has one (cpus 8-11).
+    for (int cpu = 0; cpu < 12; ++cpu) {
+        const int package = cpu < 8 ? 0 : 1;
+        const std::string l3 = cpu < 4 ? "0-3" : cpu < 8 ? "4-7" : "8-11";
+        add_cpu(cpu, package, (cpu % 8) / 2, l3);
+    }
+    const auto topology = CpuTopology::read(root_);
+    ASSERT_EQ(topology.cpus().size(), 12);
+
+    const auto expect_pair = [&](const Placement placement, const int first, const int second) {
+        const auto pair = topology.pair(placement);
+        ASSERT_TRUE(pair) << placement_name(placement);
+        EXPECT_EQ(pair->first, first) << placement_name(placement);
+        EXPECT_EQ(pair->second, second) << placement_name(placement);
+    };
+    expect_pair(Placement::SmtSiblings, 0, 1);
+    expect_pair(Placement::SameL3, 0, 2);
+    expect_pair(Placement::DifferentL3, 0, 4);
+    expect_pair(Placement::DifferentSocket, 0, 8);
+    expect_pair(Placement::Unpinned, -1, -1);
+}
+
+TEST_F(CpuTopologyTest, MissingCacheInfoDisablesL3PlacementsTest) {
+    for (int cpu = 0; cpu < 4; ++cpu) add_cpu(cpu, 0, cpu, "");
+    const auto topology = CpuTopology::read(root_);
+
+    EXPECT_FALSE(topology.pair(Placement::SmtSiblings));
+    EXPECT_FALSE(topology.pair(Placement::SameL3));
+    EXPECT_FALSE(topology.pair(Placement::DifferentL3));
+    EXPECT_FALSE(topology.pair(Placement::DifferentSocket));
+    EXPECT_TRUE(topology.pair(Placement::Unpinned));
+}
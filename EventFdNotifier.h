@@ -0,0 +1,128 @@
+#ifndef EVENTFDNOTIFIER_H
+#define EVENTFDNOTIFIER_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "ConcurrentQueueConcept.h"
+#include "QueueTypeTraits.h"
+
+// Owns a non-blocking eventfd. notify() makes the descriptor readable, acknowledge() resets it.
+class EventFd {
+public:
+    EventFd() : fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        if (fd_ < 0) throw std::system_error(errno, std::system_category(), "eventfd");
+    }
+
+    EventFd(const EventFd&) = delete;
+    EventFd& operator=(const EventFd&) = delete;
+
+    ~EventFd() { ::close(fd_); }
+
+    [[nodiscard]] int fd() const { return fd_; }
+
+    void notify() const {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const auto written = ::write(fd_, &one, sizeof(one));
+    }
+
+    void acknowledge() const {
+        std::uint64_t count;
+        [[maybe_unused]] const auto read = ::read(fd_, &count, sizeof(count));
+    }
+
+private:
+    int fd_;
+};
+
+/**
+ * @brief Adds an eventfd readiness notification to any ConcurrentQueue
+ *
+ * For consumers that live in an epoll loop and so cannot block in pop(). Register fd() for
+ * EPOLLIN; when it fires, call acknowledge() and then try_pop() until it returns false.
+ *
+ * The consumer arms the notifier when try_pop() finds the queue empty, and only a push that
+ * finds it armed writes to the eventfd, so each empty to non-empty transition costs one syscall
+ * and pushes to a queue the consumer is still draining cost none. Arming and pushing are ordered
+ * with the usual store-fence-load pairing on both sides so a push cannot slip in between the
+ * consumer seeing an empty queue and arming.
+ */
+template <typename Queue>
+class NotifyingQueue : public Queue {
+public:
+    using value_type = typename Queue::value_type;
+
+    template <typename... Args>
+    explicit NotifyingQueue(Args&&... args) : Queue(std::forward<Args>(args)...) {}
+
+    [[nodiscard]] int fd() const { return event_.fd(); }
+
+    void acknowledge() const { event_.acknowledge(); }
+
+    bool push(const value_type& item) {
+        if (!Queue::push(item)) return false;
+        signal();
+        return true;
+    }
+
+    bool try_push(const value_type& item) {
+        if (!Queue::try_push(item)) return false;
+        signal();
+        return true;
+    }
+
+    bool try_pop(value_type& item) {
+        if (Queue::try_pop(item)) return true;
+        armed_.store(true, std::memory_order::relaxed);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (!Queue::try_pop(item)) return false;
+        // Lost the race with a push; disarm so it does not leave a spurious wakeup behind.
+        armed_.store(false, std::memory_order::relaxed);
+        return true;
+    }
+
+    [[nodiscard]] std::uint64_t notifications() const {
+        return notifications_.load(std::memory_order::relaxed);
+    }
+
+private:
+    void signal() {
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (armed_.load(std::memory_order::relaxed) &&
+            armed_.exchange(false, std::memory_order::relaxed)) {
+            notifications_.fetch_add(1, std::memory_order::relaxed);
+            event_.notify();
+        }
+    }
+
+    EventFd event_;
+    alignas(64) std::atomic<bool> armed_{true};
+    std::atomic<std::uint64_t> notifications_{0};
+};
+
+template <typename Queue>
+struct is_bounded<NotifyingQueue<Queue>> : is_bounded<Queue> {};
+
+template <typename Queue>
+struct max_producers<NotifyingQueue<Queue>> : max_producers<Queue> {};
+
+template <typename Queue>
+struct max_consumers<NotifyingQueue<Queue>> : max_consumers<Queue> {};
+
+template <typename Queue>
+struct is_blocking<NotifyingQueue<Queue>> : is_blocking<Queue> {};
+
+template <typename Queue>
+struct is_lossy<NotifyingQueue<Queue>> : is_lossy<Queue> {};
+
+// The inherited try_pop_bulk() never arms the notifier, so it is not part of the interface.
+template <typename Queue>
+struct supports_batch<NotifyingQueue<Queue>> : std::false_type {};
+
+#endif  // EVENTFDNOTIFIER_H
@@ -0,0 +1,167 @@
+#ifndef HAZARDPOINTERS_H
+#define HAZARDPOINTERS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct ReclamationStats {
+    std::uint64_t retired = 0;
+    std::uint64_t reclaimed = 0;
+    std::uint64_t scans = 0;
+    std::uint64_t scan_ns = 0;
+
+    ReclamationStats& operator+=(const ReclamationStats& other) {
+        retired += other.retired;
+        reclaimed += other.reclaimed;
+        scans += other.scans;
+        scan_ns += other.scan_ns;
+        return *this;
+    }
+};
+
+/**
+ * @brief Hazard pointer domain
+ *
+ * Every thread that touches the domain owns a record holding SLOTS hazard pointers and a private
+ * retire list. A retired node is handed to Reclaim once a batched scan of all records finds no
+ * hazard pointer referencing it. Records are never freed before the domain itself, so a record
+ * left behind by an exited thread is adopted by the next thread with the same id.
+ */
+template <typename Node, typename Reclaim, std::size_t SLOTS = 2>
+class HazardPointerDomain {
+public:
+    class alignas(64) Record {
+        friend class HazardPointerDomain;
+
+        std::array<std::atomic<Node*>, SLOTS> hazards_{};
+        std::vector<Node*> retired_;
+        std::vector<Node*> scratch_;
+        ReclamationStats stats_;
+        std::thread::id owner_;
+        Record* next_ = nullptr;
+    };
+
+    explicit HazardPointerDomain(Reclaim reclaim) : reclaim_(std::move(reclaim)) {}
+
+    HazardPointerDomain(const HazardPointerDomain&) = delete;
+    HazardPointerDomain& operator=(const HazardPointerDomain&) = delete;
+
+    ~HazardPointerDomain() {
+        reclaim_all();
+        Record* rec = records_.load(std::memory_order::acquire);
+        while (rec) {
+            Record* next = rec->next_;
+            delete rec;
+            rec = next;
+        }
+    }
+
+    // Record owned by the calling thread, cached thread-locally per domain.
+    Record& record() {
+        thread_local std::array<std::pair<std::uint64_t, Record*>, kCACHED_DOMAINS> cache{};
+        auto& entry = cache[id_ % kCACHED_DOMAINS];
+        if (entry.first != id_) entry = {id_, acquire_record()};
+        return *entry.second;
+    }
+
+    Node* protect(Record& rec, const std::size_t slot, const std::atomic<Node*>& src) {
+        Node* ptr = src.load(std::memory_order::relaxed);
+        for (;;) {
+            rec.hazards_[slot].store(ptr, std::memory_order::seq_cst);
+            Node* reloaded = src.load(std::memory_order::seq_cst);
+            if (reloaded == ptr) return ptr;
+            ptr = reloaded;
+        }
+    }
+
+    void clear(Record& rec) {
+        for (auto& hazard : rec.hazards_) hazard.store(nullptr, std::memory_order::release);
+    }
+
+    void retire(Record& rec, Node* node) {
+        rec.retired_.push_back(node);
+        ++rec.stats_.retired;
+        if (rec.retired_.size() >= scan_threshold()) scan(rec);
+    }
+
+    // Only meaningful while no thread is operating on the domain.
+    [[nodiscard]] ReclamationStats stats() const {
+        ReclamationStats total;
+        for (Record* rec = records_.load(std::memory_order::acquire); rec; rec = rec->next_)
+            total += rec->stats_;
+        return total;
+    }
+
+    // Reclaims every retired node regardless of hazards; the caller guarantees quiescence.
+    void reclaim_all() {
+        for (Record* rec = records_.load(std::memory_order::acquire); rec; rec = rec->next_) {
+            for (Node* node : rec->retired_) reclaim_(node);
+            rec->stats_.reclaimed += rec->retired_.size();
+            rec->retired_.clear();
+        }
+    }
+
+private:
+    static constexpr std::size_t kCACHED_DOMAINS = 8;
+    static constexpr std::size_t kMIN_SCAN_BATCH = 64;
+
+    [[nodiscard]] std::size_t scan_threshold() const {
+        return std::max(kMIN_SCAN_BATCH,
+                        2 * SLOTS * record_count_.load(std::memory_order::relaxed));
+    }
+
+    Record* acquire_record() {
+        const auto me = std::this_thread::get_id();
+        for (Record* rec = records_.load(std::memory_order::acquire); rec; rec = rec->next_)
+            if (rec->owner_ == me) return rec;
+
+        auto* rec = new Record;
+        rec->owner_ = me;
+        rec->next_ = records_.load(std::memory_order::relaxed);
+        while (!records_.compare_exchange_weak(rec->next_, rec, std::memory_order::release,
+                                               std::memory_order::relaxed)) {}
+        record_count_.fetch_add(1, std::memory_order::relaxed);
+        return rec;
+    }
+
+    void scan(Record& rec) {
+        const auto start = std::chrono::steady_clock::now();
+
+        auto& hazards = rec.scratch_;
+        hazards.clear();
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        for (Record* r = records_.load(std::memory_order::acquire); r; r = r->next_) {
+            for (const auto& hazard : r->hazards_)
+                if (Node* ptr = hazard.load(std::memory_order::acquire)) hazards.push_back(ptr);
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        const auto keep_end =
+            std::partition(rec.retired_.begin(), rec.retired_.end(), [&](Node* node) {
+                return std::binary_search(hazards.begin(), hazards.end(), node);
+            });
+        for (auto it = keep_end; it != rec.retired_.end(); ++it) reclaim_(*it);
+        rec.stats_.reclaimed += rec.retired_.end() - keep_end;
+        rec.retired_.erase(keep_end, rec.retired_.end());
+
+        ++rec.stats_.scans;
+        rec.stats_.scan_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+    }
+
+    static inline std::atomic<std::uint64_t> next_id_{1};
+
+    const std::uint64_t id_ = next_id_.fetch_add(1, std::memory_order::relaxed);
+    Reclaim reclaim_;
+    std::atomic<Record*> records_{nullptr};
+    std::atomic<std::size_t> record_count_{0};
+};
+
+#endif  // HAZARDPOINTERS_H
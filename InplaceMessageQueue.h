@@ -0,0 +1,196 @@
+#ifndef INPLACEMESSAGEQUEUE_H
+#define INPLACEMESSAGEQUEUE_H
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "CacheLine.h"
+
+/**
+ * @brief SPSC byte ring carrying any of a fixed set of message types, constructed in place
+ *
+ * Each record is a small header (type tag and record size) followed by the message itself, both
+ * rounded up to the strictest alignment among Msgs and at least the header size, so a message
+ * takes its own size rather than the size of the largest type and nothing is allocated. A record
+ * that would straddle the end of the ring is preceded by a wrap marker that sends the consumer
+ * back to offset 0. Each record may take at most half of the ring, so that an empty ring always
+ * has room for it together with the skipped tail.
+ *
+ * The consumer hands each message to a visitor through a per-visitor function table indexed by
+ * the tag and built at compile time, then destroys it in place. The visitor must be callable with
+ * every type in Msgs.
+ */
+template <std::size_t BYTES, typename... Msgs>
+class InplaceMessageQueue {
+    static_assert(sizeof...(Msgs) > 0, "InplaceMessageQueue needs at least one message type");
+    static_assert(sizeof...(Msgs) < 0xFFFF, "too many message types for a 16-bit tag");
+    static_assert(std::has_single_bit(BYTES), "BYTES must be a power of two");
+    static_assert((std::is_nothrow_destructible_v<Msgs> && ...), "messages must not throw");
+
+    struct Header {
+        std::uint16_t tag_;
+        std::uint32_t size_;  // whole record, header included
+    };
+
+    // Records are also rounded to at least a header's size, so whenever a record does not fit
+    // before the end of the ring there is still room there for the wrap marker.
+    static constexpr std::size_t kALIGN =
+        std::max({sizeof(Header), alignof(Header), alignof(Msgs)...});
+    static_assert(std::has_single_bit(kALIGN) && BYTES % kALIGN == 0);
+    static constexpr std::uint16_t kWRAP = 0xFFFF;
+
+    static constexpr std::size_t round_up(const std::size_t bytes) {
+        return (bytes + kALIGN - 1) / kALIGN * kALIGN;
+    }
+
+    static constexpr std::size_t kHEADER = round_up(sizeof(Header));
+
+    template <typename M>
+    static constexpr std::size_t kRECORD = kHEADER + round_up(sizeof(M));
+
+    template <typename M>
+    static constexpr std::uint16_t tag_of() {
+        constexpr std::array<bool, sizeof...(Msgs)> matches{std::is_same_v<M, Msgs>...};
+        static_assert(std::ranges::count(matches, true) == 1,
+                      "M must appear exactly once in the queue's message types");
+        return static_cast<std::uint16_t>(std::ranges::find(matches, true) - matches.begin());
+    }
+
+public:
+    using size_type = std::size_t;
+
+    InplaceMessageQueue() = default;
+    InplaceMessageQueue(const InplaceMessageQueue&) = delete;
+    InplaceMessageQueue& operator=(const InplaceMessageQueue&) = delete;
+
+    ~InplaceMessageQueue() {
+        consume_all([](const auto&) {});
+    }
+
+    template <typename M, typename... Args>
+    bool try_emplace(Args&&... args) {
+        // A record that has to wrap also needs the skipped tail of the ring, which is at most one
+        // record minus a header, so an empty ring only takes any record of up to half its size.
+        static_assert(2 * kRECORD<M> <= BYTES, "message does not fit in half of the ring");
+        constexpr std::size_t need = kRECORD<M>;
+
+        auto tail = tail_.load(std::memory_order::relaxed);
+        const std::size_t contiguous = BYTES - (tail & (BYTES - 1));
+        const std::size_t skip = need > contiguous ? contiguous : 0;
+        if (tail + skip + need - cached_head_ > BYTES) {
+            cached_head_ = head_.load(std::memory_order::acquire);
+            if (tail + skip + need - cached_head_ > BYTES) return false;
+        }
+        if (skip) {
+            write_header(tail, kWRAP, skip);
+            tail += skip;
+        }
+        ::new (payload(tail)) M(std::forward<Args>(args)...);
+        write_header(tail, tag_of<M>(), need);
+        tail_.store(tail + need, std::memory_order::release);
+        return true;
+    }
+
+    // args are only consumed by the attempt that succeeds, so retrying with them is safe.
+    template <typename M, typename... Args>
+    bool emplace(Args&&... args) {
+        while (!try_emplace<M>(std::forward<Args>(args)...)) _mm_pause();
+        return true;
+    }
+
+    template <typename M>
+    bool try_push(M&& message) {
+        return try_emplace<std::remove_cvref_t<M>>(std::forward<M>(message));
+    }
+
+    template <typename M>
+    bool push(M&& message) {
+        return emplace<std::remove_cvref_t<M>>(std::forward<M>(message));
+    }
+
+    // Consumer: visits and destroys the oldest message, if any.
+    template <typename Visitor>
+    bool try_consume(Visitor&& visitor) {
+        const auto head = head_.load(std::memory_order::relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order::acquire);
+            if (head == cached_tail_) return false;
+        }
+        head_.store(consume_one(head, visitor), std::memory_order::release);
+        return true;
+    }
+
+    // Consumer: visits every message published so far, releasing the space once at the end.
+    template <typename Visitor>
+    size_type consume_all(Visitor&& visitor) {
+        auto head = head_.load(std::memory_order::relaxed);
+        cached_tail_ = tail_.load(std::memory_order::acquire);
+        size_type count = 0;
+        for (; head != cached_tail_; ++count) head = consume_one(head, visitor);
+        head_.store(head, std::memory_order::release);
+        return count;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return head_.load(std::memory_order::relaxed) == tail_.load(std::memory_order::relaxed);
+    }
+
+    // Bytes a message of type M occupies in the ring.
+    template <typename M>
+    [[nodiscard]] static constexpr size_type record_size() {
+        return kRECORD<M>;
+    }
+
+private:
+    template <typename Visitor, typename M>
+    static void visit(std::byte* bytes, Visitor& visitor) {
+        M* message = std::launder(reinterpret_cast<M*>(bytes));
+        visitor(*message);
+        std::destroy_at(message);
+    }
+
+    template <typename Visitor>
+    static constexpr std::array<void (*)(std::byte*, Visitor&), sizeof...(Msgs)> kDISPATCH{
+        &visit<Visitor, Msgs>...};
+
+    template <typename Visitor>
+    size_type consume_one(size_type head, Visitor& visitor) {
+        Header header = read_header(head);
+        if (header.tag_ == kWRAP) {
+            head += header.size_;
+            header = read_header(head);
+        }
+        kDISPATCH<std::remove_reference_t<Visitor>>[header.tag_](payload(head), visitor);
+        return head + header.size_;
+    }
+
+    std::byte* record(const size_type position) { return data_ + (position & (BYTES - 1)); }
+    std::byte* payload(const size_type position) { return record(position) + kHEADER; }
+
+    void write_header(const size_type position, const std::uint16_t tag, const std::size_t size) {
+        ::new (record(position)) Header{tag, static_cast<std::uint32_t>(size)};
+    }
+
+    Header read_header(const size_type position) {
+        return *std::launder(reinterpret_cast<Header*>(record(position)));
+    }
+
+    alignas(std::max(kALIGN, CACHE_LINE_SIZE)) std::byte data_[BYTES];
+    alignas(CACHE_LINE_SIZE) std::atomic<size_type> head_{0};
+    alignas(CACHE_LINE_SIZE) size_type cached_head_ = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_type> tail_{0};
+    alignas(CACHE_LINE_SIZE) size_type cached_tail_ = 0;
+    char padding_[CACHE_LINE_SIZE - sizeof(size_type)];
+};
+
+#endif  // INPLACEMESSAGEQUEUE_H
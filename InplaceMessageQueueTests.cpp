@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "InplaceMessageQueue.h"
+
+namespace {
+
+struct Small {
+    std::uint32_t value;
+};
+
+struct Large {
+    std::uint64_t value;
+    std::uint64_t words[31];
+};
+
+struct Owning {
+    std::string text;
+};
+
+}  // namespace
+
+class InplaceMessageQueueTest : public testing::Test {};
+
+TEST_F(InplaceMessageQueueTest, DispatchesEachTypeInOrderTest) {
+    InplaceMessageQueue<4096, Small, Large, Owning> queue;
+    EXPECT_TRUE(queue.try_push(Small{1}));
+    EXPECT_TRUE(queue.try_emplace<Owning>(std::string(100, 'x')));
+    EXPECT_TRUE(queue.try_push(Large{3, {}}));
+    EXPECT_LT(queue.record_size<Small>(), queue.record_size<Large>());
+
+    std::vector<std::string> seen;
+    const auto visitor = [&](const auto& message) {
+        using M = std::remove_cvref_t<decltype(message)>;
+        if constexpr (std::is_same_v<M, Owning>)
+            seen.push_back(message.text);
+        else
+            seen.push_back(std::to_string(message.value));
+    };
+    EXPECT_TRUE(queue.try_consume(visitor));
+    EXPECT_EQ(queue.consume_all(visitor), 2);
+    EXPECT_FALSE(queue.try_consume(visitor));
+    EXPECT_EQ(seen, (std::vector<std::string>{"1", std::string(100, 'x'), "3"}));
+}
+
+TEST_F(InplaceMessageQueueTest, DestroysMessagesLeftInRingTest) {
+    auto tracker = std::make_shared<int>(0);
+    struct Tracked {
+        std::shared_ptr<int> ref;
+    };
+    {
+        InplaceMessageQueue<1024, Tracked> queue;
+        for (int i = 0; i < 5; ++i) EXPECT_TRUE(queue.try_push(Tracked{tracker}));
+        EXPECT_EQ(tracker.use_count(), 6);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST_F(InplaceMessageQueueTest, FullRingRejectsAndWrapsTest) {
+    InplaceMessageQueue<1024, Small, Large> queue;
+    int pushed = 0;
+    while (queue.try_push(Large{static_cast<std::uint64_t>(pushed), {}})) ++pushed;
+    EXPECT_EQ(pushed, 1024 / queue.record_size<Large>());
+    EXPECT_TRUE(queue.try_consume([](const auto&) {}));
+    // The end of the ring is too short for another record, so this one goes after a wrap marker
+    // into the space freed at the front.
+    EXPECT_TRUE(queue.try_push(Large{99, {}}));
+    EXPECT_EQ(queue.consume_all([](const auto&) {}), pushed);
+}
+
+TEST_F(InplaceMessageQueueTest, HalfRingRecordFitsAtEveryOffsetTest) {
+    struct Half {
+        std::uint64_t words[15];
+    };
+    InplaceMessageQueue<256, Small, Half> queue;
+    ASSERT_EQ(queue.record_size<Half>(), 128);
+
+    // Each round leaves the tail at a different offset, so the Half record sometimes needs the
+    // wrap marker; an empty ring must still take it.
+    for (std::uint32_t n = 0; n < 64; ++n) {
+        for (std::uint32_t i = 0; i <= n % 8; ++i) EXPECT_TRUE(queue.try_push(Small{i}));
+        queue.consume_all([](const auto&) {});
+        ASSERT_TRUE(queue.try_push(Half{{n}})) << "round " << n;
+        EXPECT_EQ(queue.consume_all([](const auto&) {}), 1);
+    }
+}
+
+TEST_F(InplaceMessageQueueTest, WrapsWithOnlyFourByteAlignedTypesTest) {
+    struct Triple {
+        std::uint32_t value;
+        std::uint32_t rest[2];
+    };
+    InplaceMessageQueue<64, std::uint32_t, Triple> queue;
+    EXPECT_EQ(queue.record_size<std::uint32_t>() % 8, 0);
+
+    // Mixed sizes walk the tail through every record boundary, including right before the end.
+    std::vector<std::uint32_t> seen;
+    const auto visitor = [&]<typename M>(const M& message) {
+        if constexpr (std::is_same_v<M, Triple>)
+            seen.push_back(message.value);
+        else
+            seen.push_back(message);
+    };
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t n = 0; n < 60; ++n) {
+        if (n % 7 == 0)
+            EXPECT_TRUE(queue.try_push(Triple{n, {n, n}}));
+        else
+            EXPECT_TRUE(queue.try_push(n));
+        expected.push_back(n);
+        if (n % 2 == 1) {
+            EXPECT_EQ(queue.consume_all(visitor), 2);
+        }
+    }
+    EXPECT_EQ(seen, expected);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(InplaceMessageQueueTest, ConcurrentMixedTrafficTest) {
+    constexpr std::uint64_t kMESSAGES = 100'000;
+    auto queue = std::make_unique<InplaceMessageQueue<65536, Small, Large>>();
+
+    std::thread producer([&] {
+        for (std::uint64_t n = 0; n < kMESSAGES; ++n) {
+            if (n % 3 == 0) {
+                Large large{n, {}};
+                for (auto& word : large.words) word = n;
+                queue->push(large);
+            } else {
+                queue->push(Small{static_cast<std::uint32_t>(n)});
+            }
+        }
+    });
+
+    std::uint64_t expected = 0;
+    int errors = 0;
+    const auto visitor = [&]<typename M>(const M& message) {
+        if constexpr (std::is_same_v<M, Large>) {
+            if (expected % 3 != 0) ++errors;
+            for (const auto word : message.words)
+                if (word != expected) ++errors;
+        } else if (expected % 3 == 0) {
+            ++errors;
+        }
+        if (message.value != expected) ++errors;
+        ++expected;
+    };
+    while (expected < kMESSAGES) queue->consume_all(visitor);
+    producer.join();
+
+    EXPECT_EQ(errors, 0);
+    EXPECT_TRUE(queue->empty());
+}
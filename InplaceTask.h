@@ -0,0 +1,93 @@
+#ifndef INPLACETASK_H
+#define INPLACETASK_H
+
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Type-erased void() callable stored inline
+ *
+ * Callables up to CAPACITY bytes are constructed in the object itself, so building, copying and
+ * running a task never allocates. Larger callables are rejected at compile time rather than
+ * silently spilling to the heap. The default size makes the whole task one cache line.
+ */
+template <std::size_t CAPACITY = 48>
+class InplaceTask {
+public:
+    InplaceTask() = default;
+
+    template <typename F>
+        requires(!std::same_as<std::decay_t<F>, InplaceTask> && std::invocable<std::decay_t<F>&>)
+    InplaceTask(F&& f) {  // NOLINT(google-explicit-constructor)
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= CAPACITY, "callable does not fit in InplaceTask");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable is over-aligned");
+        static_assert(std::is_copy_constructible_v<Fn>,
+                      "queues copy tasks, so Fn must be copyable");
+        ::new (storage_) Fn(std::forward<F>(f));
+        ops_ = &kOPS<Fn>;
+    }
+
+    InplaceTask(const InplaceTask& other) : ops_(other.ops_) {
+        if (ops_) ops_->copy(storage_, other.storage_);
+    }
+
+    InplaceTask(InplaceTask&& other) noexcept : ops_(other.ops_) {
+        if (ops_) ops_->move(storage_, other.storage_);
+    }
+
+    InplaceTask& operator=(const InplaceTask& other) {
+        if (this != &other) {
+            reset();
+            if (other.ops_) other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+        return *this;
+    }
+
+    InplaceTask& operator=(InplaceTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_) other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+        return *this;
+    }
+
+    ~InplaceTask() { reset(); }
+
+    explicit operator bool() const { return ops_ != nullptr; }
+
+    void operator()() { ops_->invoke(storage_); }
+
+    void reset() {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void*);
+        void (*copy)(void* dst, const void* src);
+        void (*move)(void* dst, void* src);
+        void (*destroy)(void*);
+    };
+
+    template <typename Fn>
+    static constexpr Ops kOPS{
+        [](void* self) { (*static_cast<Fn*>(self))(); },
+        [](void* dst, const void* src) { ::new (dst) Fn(*static_cast<const Fn*>(src)); },
+        [](void* dst, void* src) { ::new (dst) Fn(std::move(*static_cast<Fn*>(src))); },
+        [](void* self) { static_cast<Fn*>(self)->~Fn(); },
+    };
+
+    alignas(std::max_align_t) std::byte storage_[CAPACITY];
+    const Ops* ops_ = nullptr;
+};
+
+#endif  // INPLACETASK_H
@@ -0,0 +1,95 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "CacheLine.h"
+
+/**
+ * @brief Fixed-size log-linear histogram of latencies, in the style of HdrHistogram
+ *
+ * Values below 2^(kSUB_BUCKET_BITS + 1) get a bucket each. Every power-of-two range above that is
+ * split into 2^kSUB_BUCKET_BITS equal buckets, so a recorded value is off by at most ~3% across
+ * the whole 64-bit range, using a few thousand counters and no allocation. record() is a couple
+ * of shifts and an increment, cheap enough to call for every message.
+ *
+ * A histogram is not thread safe: give each thread its own and merge() them once the threads
+ * are done. Instances are cache-line aligned so neighbours in a vector don't false-share.
+ */
+class alignas(CACHE_LINE_SIZE) LatencyHistogram {
+public:
+    static constexpr unsigned kSUB_BUCKET_BITS = 5;
+    static constexpr std::size_t kSUB_BUCKETS = std::size_t{1} << kSUB_BUCKET_BITS;
+    static constexpr std::size_t kBUCKETS = (65 - kSUB_BUCKET_BITS) * kSUB_BUCKETS;
+
+    void record(const std::uint64_t value) {
+        ++counts_[bucket_of(value)];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (std::size_t i = 0; i < kBUCKETS; ++i) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void reset() { *this = LatencyHistogram{}; }
+
+    // Smallest recorded value v such that at least p percent of all values are <= v, reported as
+    // the top of its bucket and never above the true maximum.
+    [[nodiscard]] std::uint64_t percentile(const double p) const {
+        if (count_ == 0) return 0;
+        const auto rank = std::max<std::uint64_t>(
+            1, static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count_))));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::min(highest_in_bucket(i), max_);
+        }
+        return max_;
+    }
+
+    [[nodiscard]] std::uint64_t count() const { return count_; }
+    [[nodiscard]] std::uint64_t min() const { return count_ ? min_ : 0; }
+    [[nodiscard]] std::uint64_t max() const { return max_; }
+
+    [[nodiscard]] double mean() const {
+        return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+    }
+
+    static constexpr std::size_t bucket_of(const std::uint64_t value) {
+        if (value < 2 * kSUB_BUCKETS) return static_cast<std::size_t>(value);
+        const unsigned shift = std::bit_width(value) - 1 - kSUB_BUCKET_BITS;
+        return (shift + 1) * kSUB_BUCKETS + ((value >> shift) - kSUB_BUCKETS);
+    }
+
+    static constexpr std::uint64_t highest_in_bucket(const std::size_t bucket) {
+        if (bucket < 2 * kSUB_BUCKETS) return bucket;
+        const auto shift = static_cast<unsigned>(bucket / kSUB_BUCKETS - 1);
+        const std::uint64_t lowest = (bucket % kSUB_BUCKETS + kSUB_BUCKETS) << shift;
+        return lowest + ((std::uint64_t{1} << shift) - 1);
+    }
+
+private:
+    std::array<std::uint64_t, kBUCKETS> counts_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max_ = 0;
+};
+
+static_assert(LatencyHistogram::bucket_of(std::numeric_limits<std::uint64_t>::max()) ==
+              LatencyHistogram::kBUCKETS - 1);
+
+#endif  // LATENCYHISTOGRAM_H
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+
+#include "LatencyHistogram.h"
+
+class LatencyHistogramTest : public testing::Test {};
+
+TEST_F(LatencyHistogramTest, BucketsStayWithinRelativeErrorTest) {
+    for (std::uint64_t value = 0; value < 1'000'000; value += value / 7 + 1) {
+        const auto bucket = LatencyHistogram::bucket_of(value);
+        const auto highest = LatencyHistogram::highest_in_bucket(bucket);
+        EXPECT_GE(highest, value);
+        EXPECT_LE(static_cast<double>(highest - value), static_cast<double>(value) / 32 + 1);
+        EXPECT_EQ(LatencyHistogram::bucket_of(highest), bucket);
+        EXPECT_EQ(LatencyHistogram::bucket_of(highest + 1), bucket + 1);
+    }
+    EXPECT_EQ(LatencyHistogram::highest_in_bucket(LatencyHistogram::kBUCKETS - 1),
+              std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST_F(LatencyHistogramTest, PercentilesOfMergedHistogramsTest) {
+    LatencyHistogram low;
+    LatencyHistogram high;
+    for (std::uint64_t v = 1; v <= 9'900; ++v) low.record(v % 50 + 1);
+    for (std::uint64_t v = 1; v <= 100; ++v) high.record(10'000 * v);
+
+    LatencyHistogram merged;
+    merged.merge(low);
+    merged.merge(high);
+    EXPECT_EQ(merged.count(), 10'000);
+    EXPECT_EQ(merged.min(), 1);
+    EXPECT_EQ(merged.max(), 1'000'000);
+    EXPECT_EQ(merged.percentile(50), 26);
+    EXPECT_EQ(merged.percentile(99), 50);
+    EXPECT_NEAR(static_cast<double>(merged.percentile(99.5)), 500'000, 500'000 / 32.0);
+    EXPECT_EQ(merged.percentile(100), 1'000'000);
+
+    merged.reset();
+    EXPECT_EQ(merged.count(), 0);
+    EXPECT_EQ(merged.percentile(99), 0);
+}
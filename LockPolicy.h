@@ -0,0 +1,66 @@
+#ifndef LOCKPOLICY_H
+#define LOCKPOLICY_H
+
+#include <emmintrin.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+
+#include "Futex.h"
+
+/**
+ * @brief Spin-then-futex mutex
+ *
+ * Drepper's three-state futex mutex (0 unlocked, 1 locked, 2 locked with sleepers) preceded by
+ * a bounded spin, so short critical sections are handed over without a syscall and long ones
+ * put waiters to sleep. unlock() only enters the kernel when a waiter may be asleep.
+ */
+class AdaptiveMutex {
+public:
+    using scoped_lock = std::lock_guard<AdaptiveMutex>;
+
+    AdaptiveMutex() = default;
+    AdaptiveMutex(const AdaptiveMutex&) = delete;
+    AdaptiveMutex& operator=(const AdaptiveMutex&) = delete;
+
+    void lock() {
+        for (unsigned spin = 0; spin < kSPIN_LIMIT; ++spin) {
+            if (state_.load(std::memory_order::relaxed) == kUNLOCKED && try_lock()) return;
+            _mm_pause();
+        }
+        if (state_.exchange(kCONTENDED, std::memory_order::acquire) == kUNLOCKED) return;
+        do {
+            futex_wait(state_, kCONTENDED);
+        } while (state_.exchange(kCONTENDED, std::memory_order::acquire) != kUNLOCKED);
+    }
+
+    bool try_lock() {
+        auto expected = kUNLOCKED;
+        return state_.compare_exchange_strong(expected, kLOCKED, std::memory_order::acquire,
+                                              std::memory_order::relaxed);
+    }
+
+    void unlock() {
+        if (state_.exchange(kUNLOCKED, std::memory_order::release) == kCONTENDED)
+            futex_wake(state_, 1);
+    }
+
+private:
+    static constexpr std::uint32_t kUNLOCKED = 0;
+    static constexpr std::uint32_t kLOCKED = 1;
+    static constexpr std::uint32_t kCONTENDED = 2;
+    static constexpr unsigned kSPIN_LIMIT = 128;
+
+    std::atomic<std::uint32_t> state_{kUNLOCKED};
+};
+
+// std::condition_variable only works with std::mutex; any other lock type needs the _any flavour.
+template<typename Mutex>
+using condition_variable_for = std::conditional_t<std::is_same_v<Mutex, std::mutex>,
+                                                  std::condition_variable,
+                                                  std::condition_variable_any>;
+
+#endif  // LOCKPOLICY_H
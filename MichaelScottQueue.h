@@ -0,0 +1,160 @@
+#ifndef MICHAELSCOTTQUEUE_H
+#define MICHAELSCOTTQUEUE_H
+
+#include <emmintrin.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "ConcurrentQueueConcept.h"
+#include "HazardPointers.h"
+
+/**
+ * @brief Unbounded lock-free Michael-Scott queue
+ *
+ * Dequeued nodes are retired through a hazard pointer domain and, once no thread can still be
+ * reading them, pushed onto a Treiber freelist that push() allocates from. Popping the freelist
+ * is protected by the same hazard pointers, which is what keeps it free of ABA: a node cannot
+ * return to the freelist while another thread holds a hazard on it.
+ */
+template <typename T>
+class MichaelScottQueue {
+public:
+    using value_type = T;
+
+    MichaelScottQueue() : domain_(Recycler{this}) {
+        auto* dummy = new Node;
+        head_.store(dummy, std::memory_order::relaxed);
+        tail_.store(dummy, std::memory_order::relaxed);
+    }
+
+    MichaelScottQueue(const MichaelScottQueue&) = delete;
+    MichaelScottQueue& operator=(const MichaelScottQueue&) = delete;
+
+    ~MichaelScottQueue() {
+        domain_.reclaim_all();
+        delete_chain(head_.load(std::memory_order::relaxed));
+        delete_chain(free_.load(std::memory_order::relaxed));
+    }
+
+    bool push(const T& item) {
+        auto& rec = domain_.record();
+        Node* node = allocate(rec);
+        node->value_ = item;
+        node->next_.store(nullptr, std::memory_order::relaxed);
+
+        for (;;) {
+            Node* tail = domain_.protect(rec, 0, tail_);
+            Node* next = tail->next_.load(std::memory_order::acquire);
+            if (tail != tail_.load(std::memory_order::acquire)) continue;
+            if (next != nullptr) {
+                tail_.compare_exchange_weak(tail, next, std::memory_order::release,
+                                            std::memory_order::relaxed);
+                continue;
+            }
+            if (tail->next_.compare_exchange_weak(next, node, std::memory_order::release,
+                                                  std::memory_order::relaxed)) {
+                tail_.compare_exchange_strong(tail, node, std::memory_order::release,
+                                              std::memory_order::relaxed);
+                break;
+            }
+        }
+        domain_.clear(rec);
+        return true;
+    }
+
+    bool try_push(const T& item) { return push(item); }
+
+    bool pop(T& item) {
+        while (!try_pop(item)) _mm_pause();
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        auto& rec = domain_.record();
+        for (;;) {
+            Node* head = domain_.protect(rec, 0, head_);
+            Node* tail = tail_.load(std::memory_order::acquire);
+            Node* next = domain_.protect(rec, 1, head->next_);
+            if (head != head_.load(std::memory_order::acquire)) continue;
+            if (next == nullptr) {
+                domain_.clear(rec);
+                return false;
+            }
+            if (head == tail) {
+                tail_.compare_exchange_weak(tail, next, std::memory_order::release,
+                                            std::memory_order::relaxed);
+                continue;
+            }
+            item = next->value_;
+            if (head_.compare_exchange_weak(head, next, std::memory_order::acq_rel,
+                                            std::memory_order::relaxed)) {
+                domain_.clear(rec);
+                domain_.retire(rec, head);
+                return true;
+            }
+        }
+    }
+
+    // Only meaningful while no thread is operating on the queue.
+    [[nodiscard]] ReclamationStats reclamation_stats() const { return domain_.stats(); }
+    [[nodiscard]] std::uint64_t allocated_nodes() const {
+        return allocated_nodes_.load(std::memory_order::relaxed);
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next_{nullptr};
+        T value_{};
+    };
+
+    struct Recycler {
+        MichaelScottQueue* queue_;
+        void operator()(Node* node) const { queue_->recycle(node); }
+    };
+
+    using Domain = HazardPointerDomain<Node, Recycler>;
+
+    Node* allocate(typename Domain::Record& rec) {
+        for (;;) {
+            Node* top = domain_.protect(rec, 0, free_);
+            if (top == nullptr) break;
+            Node* next = top->next_.load(std::memory_order::relaxed);
+            if (free_.compare_exchange_weak(top, next, std::memory_order::acquire,
+                                            std::memory_order::relaxed)) {
+                domain_.clear(rec);
+                return top;
+            }
+        }
+        domain_.clear(rec);
+        allocated_nodes_.fetch_add(1, std::memory_order::relaxed);
+        return new Node;
+    }
+
+    void recycle(Node* node) {
+        Node* top = free_.load(std::memory_order::relaxed);
+        do {
+            node->next_.store(top, std::memory_order::relaxed);
+        } while (!free_.compare_exchange_weak(top, node, std::memory_order::release,
+                                              std::memory_order::relaxed));
+    }
+
+    static void delete_chain(Node* node) {
+        while (node) {
+            Node* next = node->next_.load(std::memory_order::relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    alignas(64) std::atomic<Node*> head_{nullptr};
+    alignas(64) std::atomic<Node*> tail_{nullptr};
+    alignas(64) std::atomic<Node*> free_{nullptr};
+    std::atomic<std::uint64_t> allocated_nodes_{0};
+    Domain domain_;
+};
+
+static_assert(ConcurrentQueue<MichaelScottQueue<int>>,
+              "MichaelScottQueue does not satisfy the ConcurrentQueue concept");
+
+#endif  // MICHAELSCOTTQUEUE_H
@@ -39,8 +39,11 @@ private:
 template<typename T>
 struct is_bounded<MoodyCamelBlockingQueue<T>> : std::true_type {};
 
-static_assert(ConcurrentQueue<MoodyCamelBlockingQueue<int>>,
-              "MoodyCamelBlockingQueue does not satisfy the ConcurrentQueue concept");
+template<typename T>
+struct is_blocking<MoodyCamelBlockingQueue<T>> : std::true_type {};
+
+static_assert(BlockingQueue<MoodyCamelBlockingQueue<int>>,
+              "MoodyCamelBlockingQueue does not satisfy the BlockingQueue concept");
 
 template<typename T>
 class MoodyCamelLockFreeQueue {
@@ -53,10 +56,19 @@ public:
         return queue_.enqueue(item);
     }
 
+    // Lets move-only items such as unique_ptr through.
+    bool push(T&& item) {
+        return queue_.enqueue(std::move(item));
+    }
+
     bool try_push(const T& item) {
         return queue_.try_enqueue(item);
     }
 
+    bool try_push(T&& item) {
+        return queue_.try_enqueue(std::move(item));
+    }
+
     bool pop(T& item) {
         while (!queue_.try_dequeue(item)){}
         return true;
@@ -73,4 +85,7 @@ private:
 template<typename T>
 struct is_bounded<MoodyCamelLockFreeQueue<T>> : std::true_type {};
 
+static_assert(ConcurrentQueue<MoodyCamelLockFreeQueue<int>>,
+              "MoodyCamelLockFreeQueue does not satisfy the ConcurrentQueue concept");
+
 #endif //MOODEYCAMELQUEUES_H
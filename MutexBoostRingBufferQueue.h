@@ -5,10 +5,11 @@
 #include <mutex>
 
 #include "ConcurrentQueueConcept.h"
+#include "NotifyPolicy.h"
 #include "boost/call_traits.hpp"
 #include "boost/circular_buffer.hpp"
 
-template <class T>
+template <class T, class Notify = NotifyWaiters>
 class MutexBoostRingBufferQueue {
 public:
     using container_type = boost::circular_buffer<T>;
@@ -23,47 +24,66 @@ public:
     MutexBoostRingBufferQueue& operator=(const MutexBoostRingBufferQueue&) = delete;
 
     bool push(param_type item) {
+        bool notify;
         {
             std::unique_lock lock(m_mutex);
-            m_not_full.wait(lock, [&] { return is_not_full(); });
+            m_not_full_waiters.wait(m_not_full, lock, [&] { return is_not_full(); });
+            const bool was_empty = !is_not_empty();
             m_container.push_front(item);
             ++m_unread;
+            notify = m_not_empty_waiters.should_notify(was_empty);
         }
-        m_not_empty.notify_one();
+        if (notify) m_not_empty.notify_one();
         return true;
     }
 
     bool try_push(param_type item) {
+        bool notify;
         {
             const std::lock_guard lock(m_mutex);
             if (!is_not_full()) return false;
+            const bool was_empty = !is_not_empty();
             m_container.push_front(item);
             ++m_unread;
+            notify = m_not_empty_waiters.should_notify(was_empty);
         }
-        m_not_empty.notify_one();
+        if (notify) m_not_empty.notify_one();
         return true;
     }
 
     bool pop(value_type& item) {
+        bool notify;
         {
             std::unique_lock lock(m_mutex);
-            m_not_empty.wait(lock, [&] { return is_not_empty(); });
+            m_not_empty_waiters.wait(m_not_empty, lock, [&] { return is_not_empty(); });
+            const bool was_full = !is_not_full();
             item = m_container[--m_unread];
+            notify = m_not_full_waiters.should_notify(was_full);
         }
-        m_not_full.notify_one();
+        if (notify) m_not_full.notify_one();
         return true;
     }
 
     bool try_pop(value_type& item) {
+        bool notify;
         {
             const std::lock_guard lock(m_mutex);
             if (!is_not_empty()) return false;
+            const bool was_full = !is_not_full();
             item = m_container[--m_unread];
+            notify = m_not_full_waiters.should_notify(was_full);
         }
-        m_not_full.notify_one();
+        if (notify) m_not_full.notify_one();
         return true;
     }
 
+    // Only meaningful while no thread is operating on the queue.
+    [[nodiscard]] NotifyStats notify_stats() const {
+        auto stats = m_not_empty_waiters.stats();
+        stats += m_not_full_waiters.stats();
+        return stats;
+    }
+
 private:
     [[nodiscard]] bool is_not_empty() const { return m_unread > 0; }
     [[nodiscard]] bool is_not_full() const { return m_unread < m_container.capacity(); }
@@ -73,9 +93,14 @@ private:
     std::mutex m_mutex;
     std::condition_variable m_not_empty;
     std::condition_variable m_not_full;
+    Notify m_not_empty_waiters;
+    Notify m_not_full_waiters;
 };
 
-static_assert(ConcurrentQueue<MutexBoostRingBufferQueue<int>>,
-              "boost_bounded_ring_based does not satisfy the ConcurrentQueue concept");
+template <class T, class Notify>
+struct is_blocking<MutexBoostRingBufferQueue<T, Notify>> : std::true_type {};
+
+static_assert(BlockingQueue<MutexBoostRingBufferQueue<int>>,
+              "MutexBoostRingBufferQueue does not satisfy the BlockingQueue concept");
 
 #endif  // BOOST_BOUNDED_BUFFER_RING_BASED_H
@@ -1,39 +1,54 @@
 #ifndef BASICTSQUEUE_H
 #define BASICTSQUEUE_H
 
+#include <algorithm>
 #include <mutex>
 #include <condition_variable>
 #include <deque>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
 
 #include "ConcurrentQueueConcept.h"
+#include "LockPolicy.h"
+#include "NotifyPolicy.h"
 
-template<typename T>
+template<typename T, typename Mutex = std::mutex, typename Notify = NotifyWaiters,
+         typename Allocator = std::allocator<T>>
 class MutexDequeQueue {
 public:
     using value_type = T;
+    using allocator_type = Allocator;
+
+    MutexDequeQueue() = default;
+    explicit MutexDequeQueue(const Allocator& alloc) : buffer_(alloc) {}
 
     bool push(const T& item) {
+        bool notify;
         {
             const std::lock_guard lock(mutex_);
             buffer_.emplace_back(item);
+            notify = not_empty_waiters_.should_notify(buffer_.size() == 1);
         }
-        not_empty_.notify_one();
+        if (notify) not_empty_.notify_one();
         return true;
     }
 
     bool try_push(const T& item) {
+        bool notify;
         {
             const std::lock_guard lock(mutex_);
             buffer_.emplace_back(item);
+            notify = not_empty_waiters_.should_notify(buffer_.size() == 1);
         }
-        not_empty_.notify_one();
+        if (notify) not_empty_.notify_one();
         return true;
     }
 
     bool pop(T& item) {
         {
             std::unique_lock lock(mutex_);
-            not_empty_.wait(lock, [&] { return !buffer_.empty(); });
+            not_empty_waiters_.wait(not_empty_, lock, [&] { return !buffer_.empty(); });
             item = buffer_.front();
             buffer_.pop_front();
         }
@@ -50,14 +65,58 @@ public:
         return true;
     }
 
+    // Blocks until the queue is non-empty, then swaps the whole deque out under the lock and
+    // appends its contents to out. Returns the number of items appended.
+    template<typename Container>
+    std::size_t pop_all(Container& out) {
+        std::deque<T, Allocator> drained(buffer_.get_allocator());
+        {
+            std::unique_lock lock(mutex_);
+            not_empty_waiters_.wait(not_empty_, lock, [&] { return !buffer_.empty(); });
+            drained.swap(buffer_);
+        }
+        const auto count = drained.size();
+        if constexpr (std::is_same_v<Container, std::deque<T, Allocator>>) {
+            if (out.empty() && out.get_allocator() == drained.get_allocator()) {
+                out.swap(drained);
+                return count;
+            }
+        }
+        out.insert(out.end(), std::make_move_iterator(drained.begin()),
+                   std::make_move_iterator(drained.end()));
+        return count;
+    }
+
+    template<typename OutputIt>
+    std::size_t try_pop_bulk(OutputIt out, const std::size_t max) {
+        const std::lock_guard lock(mutex_);
+        const auto count = std::min(max, buffer_.size());
+        const auto last = buffer_.begin() + count;
+        std::move(buffer_.begin(), last, out);
+        buffer_.erase(buffer_.begin(), last);
+        return count;
+    }
+
+    // Only meaningful while no thread is operating on the queue.
+    [[nodiscard]] NotifyStats notify_stats() const { return not_empty_waiters_.stats(); }
+
 private:
-    std::deque<T> buffer_;
-    mutable std::mutex mutex_;
-    std::condition_variable not_empty_;
+    std::deque<T, Allocator> buffer_;
+    mutable Mutex mutex_;
+    condition_variable_for<Mutex> not_empty_;
+    Notify not_empty_waiters_;
 };
 
-static_assert(ConcurrentQueue<MutexDequeQueue<int>>,
-              "MutexDequeQueue does not satisfy the ConcurrentQueue concept");
+template<typename T, typename Mutex, typename Notify, typename Allocator>
+struct is_blocking<MutexDequeQueue<T, Mutex, Notify, Allocator>> : std::true_type {};
+
+static_assert(BlockingQueue<MutexDequeQueue<int>> && BatchQueue<MutexDequeQueue<int>>,
+              "MutexDequeQueue does not satisfy the BlockingQueue and BatchQueue concepts");
+
+namespace pmr {
+template<typename T, typename Mutex = std::mutex, typename Notify = NotifyWaiters>
+using MutexDequeQueue = ::MutexDequeQueue<T, Mutex, Notify, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 
 #endif //BASICTSQUEUE_H
 
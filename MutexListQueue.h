@@ -1,39 +1,54 @@
 #ifndef MUTEXLISTQUEUE_H
 #define MUTEXLISTQUEUE_H
 
+#include <algorithm>
 #include <mutex>
 #include <condition_variable>
+#include <iterator>
 #include <list>
+#include <memory_resource>
+#include <type_traits>
 
 #include "ConcurrentQueueConcept.h"
+#include "LockPolicy.h"
+#include "NotifyPolicy.h"
 
-template<typename T>
+template<typename T, typename Mutex = std::mutex, typename Notify = NotifyWaiters,
+         typename Allocator = std::allocator<T>>
 class MutexListQueue {
 public:
     using value_type = T;
+    using allocator_type = Allocator;
+
+    MutexListQueue() = default;
+    explicit MutexListQueue(const Allocator& alloc) : buffer_(alloc) {}
 
     bool push(const T& item) {
+        bool notify;
         {
             const std::lock_guard lock(mutex_);
             buffer_.emplace_back(item);
+            notify = not_empty_waiters_.should_notify(buffer_.size() == 1);
         }
-        not_empty_.notify_one();
+        if (notify) not_empty_.notify_one();
         return true;
     }
 
     bool try_push(const T& item) {
+        bool notify;
         {
             const std::lock_guard lock(mutex_);
             buffer_.emplace_back(item);
+            notify = not_empty_waiters_.should_notify(buffer_.size() == 1);
         }
-        not_empty_.notify_one();
+        if (notify) not_empty_.notify_one();
         return true;
     }
 
     bool pop(T& item) {
         {
             std::unique_lock lock(mutex_);
-            not_empty_.wait(lock, [&] { return !buffer_.empty(); });
+            not_empty_waiters_.wait(not_empty_, lock, [&] { return !buffer_.empty(); });
             item = buffer_.front();
             buffer_.pop_front();
         }
@@ -50,13 +65,60 @@ public:
         return true;
     }
 
+    // Blocks until the queue is non-empty, then splices every node out in O(1) under the lock and
+    // appends the items to out. Returns the number of items appended.
+    template<typename Container>
+    std::size_t pop_all(Container& out) {
+        std::list<T, Allocator> drained(buffer_.get_allocator());
+        {
+            std::unique_lock lock(mutex_);
+            not_empty_waiters_.wait(not_empty_, lock, [&] { return !buffer_.empty(); });
+            drained.splice(drained.end(), buffer_);
+        }
+        const auto count = drained.size();
+        if constexpr (std::is_same_v<Container, std::list<T, Allocator>>) {
+            if (out.get_allocator() == drained.get_allocator()) {
+                out.splice(out.end(), drained);
+                return count;
+            }
+        }
+        out.insert(out.end(), std::make_move_iterator(drained.begin()),
+                   std::make_move_iterator(drained.end()));
+        return count;
+    }
+
+    template<typename OutputIt>
+    std::size_t try_pop_bulk(OutputIt out, const std::size_t max) {
+        std::list<T, Allocator> drained(buffer_.get_allocator());
+        {
+            const std::lock_guard lock(mutex_);
+            const auto count = std::min(max, buffer_.size());
+            drained.splice(drained.end(), buffer_, buffer_.begin(),
+                           std::next(buffer_.begin(), count));
+        }
+        std::move(drained.begin(), drained.end(), out);
+        return drained.size();
+    }
+
+    // Only meaningful while no thread is operating on the queue.
+    [[nodiscard]] NotifyStats notify_stats() const { return not_empty_waiters_.stats(); }
+
 private:
-    std::list<T> buffer_;
-    mutable std::mutex mutex_;
-    std::condition_variable not_empty_;
+    std::list<T, Allocator> buffer_;
+    mutable Mutex mutex_;
+    condition_variable_for<Mutex> not_empty_;
+    Notify not_empty_waiters_;
 };
 
-static_assert(ConcurrentQueue<MutexListQueue<int>>,
-              "MutexListQueue does not satisfy the ConcurrentQueue concept");
+template<typename T, typename Mutex, typename Notify, typename Allocator>
+struct is_blocking<MutexListQueue<T, Mutex, Notify, Allocator>> : std::true_type {};
+
+static_assert(BlockingQueue<MutexListQueue<int>> && BatchQueue<MutexListQueue<int>>,
+              "MutexListQueue does not satisfy the BlockingQueue and BatchQueue concepts");
+
+namespace pmr {
+template<typename T, typename Mutex = std::mutex, typename Notify = NotifyWaiters>
+using MutexListQueue = ::MutexListQueue<T, Mutex, Notify, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 
 #endif //MUTEXLISTQUEUE_H
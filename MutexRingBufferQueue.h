@@ -1,14 +1,21 @@
 #ifndef BLOCKINGBOUNDEDQUEUE_H
 #define BLOCKINGBOUNDEDQUEUE_H
 
+#include <algorithm>
+#include <cstdint>
 #include <mutex>
 #include <condition_variable>
 
 #include "ConcurrentQueueConcept.h"
+#include "LockPolicy.h"
+#include "NotifyPolicy.h"
+#include "OverflowPolicy.h"
 #include "QueueTypeTraits.h"
 #include "RingBuffer.h"
 
-template<typename T>
+// With a drop policy push() never blocks; dropped() counts the items it discarded.
+template<typename T, typename Mutex = std::mutex, typename Notify = NotifyWaiters,
+         OverflowPolicy POLICY = OverflowPolicy::Block>
 class MutexRingBufferQueue {
 public:
     using value_type = T;
@@ -16,63 +23,136 @@ public:
     explicit MutexRingBufferQueue(std::size_t capacity = 256) : buffer_(capacity) {}
 
     bool push(const T& item) {
+        bool notify;
         {
             std::unique_lock lock(mutex_);
-            not_full_.wait(lock, [&]{ return !buffer_.full(); });
+            if constexpr (POLICY == OverflowPolicy::Block) {
+                not_full_waiters_.wait(not_full_, lock, [&] { return !buffer_.full(); });
+            } else if (buffer_.full()) {
+                ++dropped_;
+                // RingBuffer::push_back overwrites the oldest item when full.
+                if constexpr (POLICY == OverflowPolicy::DropNewest) return false;
+            }
+            const bool was_empty = buffer_.empty();
             buffer_.push_back(item);
             max_size_ = std::max(max_size_, buffer_.size());
+            notify = not_empty_waiters_.should_notify(was_empty);
         }
-        not_empty_.notify_one();
+        if (notify) not_empty_.notify_one();
         return true;
     }
 
     bool try_push(const T& item) {
+        bool notify;
         {
             const std::lock_guard lock(mutex_);
             if (buffer_.full()) return false;
+            const bool was_empty = buffer_.empty();
             buffer_.push_back(item);
             max_size_ = std::max(max_size_, buffer_.size());
+            notify = not_empty_waiters_.should_notify(was_empty);
         }
-        not_empty_.notify_one();
+        if (notify) not_empty_.notify_one();
         return true;
     }
 
     bool pop(T& item) {
+        bool notify;
         {
             std::unique_lock lock(mutex_);
-            not_empty_.wait(lock, [&] { return !buffer_.empty(); });
+            not_empty_waiters_.wait(not_empty_, lock, [&] { return !buffer_.empty(); });
+            const bool was_full = buffer_.full();
             item = buffer_.front();
             buffer_.pop_front();
+            notify = not_full_waiters_.should_notify(was_full);
         }
-        not_full_.notify_one();
+        if (notify) not_full_.notify_one();
         return true;
     }
 
     bool try_pop(T& item) {
+        bool notify;
         {
             const std::lock_guard lock(mutex_);
             if (buffer_.empty()) return false;
+            const bool was_full = buffer_.full();
             item = buffer_.front();
             buffer_.pop_front();
+            notify = not_full_waiters_.should_notify(was_full);
         }
-        not_full_.notify_one();
+        if (notify) not_full_.notify_one();
         return true;
     }
 
+    // Pushes as many of items as fit without blocking, in one critical section and with
+    // vectorised copies for trivially copyable T. Returns how many were pushed.
+    std::size_t try_push_bulk(const T* items, std::size_t count,
+                              const simd::StoreHint hint = simd::StoreHint::Cached) {
+        bool notify;
+        {
+            const std::lock_guard lock(mutex_);
+            count = std::min(count, buffer_.capacity() - buffer_.size());
+            if (count == 0) return 0;
+            const bool was_empty = buffer_.empty();
+            buffer_.push_back_bulk(items, count, hint);
+            max_size_ = std::max(max_size_, buffer_.size());
+            notify = not_empty_waiters_.should_notify(was_empty);
+        }
+        if (notify) count > 1 ? not_empty_.notify_all() : not_empty_.notify_one();
+        return count;
+    }
+
+    // Pops up to max items into out without blocking and returns how many were popped.
+    std::size_t try_pop_bulk(T* out, std::size_t max) {
+        bool notify;
+        {
+            const std::lock_guard lock(mutex_);
+            max = std::min(max, buffer_.size());
+            if (max == 0) return 0;
+            const bool was_full = buffer_.full();
+            buffer_.pop_front_bulk(out, max);
+            notify = not_full_waiters_.should_notify(was_full);
+        }
+        if (notify) max > 1 ? not_full_.notify_all() : not_full_.notify_one();
+        return max;
+    }
+
     std::size_t max_size() const { return max_size_; }
 
+    [[nodiscard]] std::uint64_t dropped() const {
+        const std::lock_guard lock(mutex_);
+        return dropped_;
+    }
+
+    // Only meaningful while no thread is operating on the queue.
+    [[nodiscard]] NotifyStats notify_stats() const {
+        auto stats = not_empty_waiters_.stats();
+        stats += not_full_waiters_.stats();
+        return stats;
+    }
+
 private:
     RingBuffer<T> buffer_;
-    mutable std::mutex mutex_;
-    std::condition_variable not_empty_;
-    std::condition_variable not_full_;
+    mutable Mutex mutex_;
+    condition_variable_for<Mutex> not_empty_;
+    condition_variable_for<Mutex> not_full_;
+    Notify not_empty_waiters_;
+    Notify not_full_waiters_;
     std::size_t max_size_ = 0;
+    std::uint64_t dropped_ = 0;
 };
 
-static_assert(ConcurrentQueue<MutexRingBufferQueue<int>>,
-              "BoundedBufferRingBased does not satisfy the ConcurrentQueue concept");
+template<typename T, typename Mutex, typename Notify, OverflowPolicy POLICY>
+struct is_bounded<MutexRingBufferQueue<T, Mutex, Notify, POLICY>> : std::true_type {};
+
+template<typename T, typename Mutex, typename Notify, OverflowPolicy POLICY>
+struct is_blocking<MutexRingBufferQueue<T, Mutex, Notify, POLICY>> : std::true_type {};
+
+template<typename T, typename Mutex, typename Notify, OverflowPolicy POLICY>
+struct is_lossy<MutexRingBufferQueue<T, Mutex, Notify, POLICY>>
+    : std::bool_constant<POLICY != OverflowPolicy::Block> {};
 
-template<typename T>
-struct is_bounded<MutexRingBufferQueue<T>> : std::true_type {};
+static_assert(BlockingQueue<MutexRingBufferQueue<int>> && BatchQueue<MutexRingBufferQueue<int>>,
+              "MutexRingBufferQueue does not satisfy the BlockingQueue and BatchQueue concepts");
 
 #endif //BLOCKINGBOUNDEDQUEUE_H
@@ -0,0 +1,181 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include "QueueTypeTraits.h"
+
+/**
+ * @brief Lock-free pooled memory resource for container nodes
+ *
+ * Requests up to kMAX_BLOCK bytes are rounded up to a power-of-two size class and served from a
+ * per-class freelist. Freed blocks go back to their freelist and are never returned to upstream
+ * until the resource is destroyed, so a steady-state list or deque never calls the global
+ * allocator. Freelists are Treiber stacks whose head packs a 16-bit ABA tag above the 48-bit
+ * pointer. Larger or over-aligned requests are forwarded to upstream.
+ */
+class NodePoolResource : public std::pmr::memory_resource {
+public:
+    explicit NodePoolResource(
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+    NodePoolResource(const NodePoolResource&) = delete;
+    NodePoolResource& operator=(const NodePoolResource&) = delete;
+
+    ~NodePoolResource() override {
+        Chunk* chunk = chunks_.load(std::memory_order::acquire);
+        while (chunk) {
+            Chunk* next = chunk->next_;
+            upstream_->deallocate(chunk, chunk->bytes_, alignof(std::max_align_t));
+            chunk = next;
+        }
+    }
+
+    [[nodiscard]] std::uint64_t upstream_allocations() const {
+        return upstream_allocations_.load(std::memory_order::relaxed);
+    }
+
+private:
+    static_assert(sizeof(void*) == 8, "tagged freelist heads assume 48-bit pointers");
+
+    static constexpr std::size_t kMIN_BLOCK = 16;
+    static constexpr std::size_t kMAX_BLOCK = 1024;
+    static constexpr std::size_t kCLASSES = std::countr_zero(kMAX_BLOCK / kMIN_BLOCK) + 1;
+    static constexpr std::size_t kCHUNK_BYTES = 64 * 1024;
+    static constexpr std::uint64_t kPTR_MASK = (std::uint64_t{1} << 48) - 1;
+
+    // Accessed through std::atomic_ref while the block is on a freelist.
+    struct Block {
+        Block* next_;
+    };
+    static_assert(std::atomic_ref<Block*>::is_always_lock_free);
+
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next_;
+        std::size_t bytes_;
+    };
+
+    struct alignas(64) FreeList {
+        std::atomic<std::uint64_t> head_{0};
+    };
+
+    [[nodiscard]] static std::size_t size_class(const std::size_t bytes) {
+        return std::bit_width(std::max(bytes, kMIN_BLOCK) - 1) - std::countr_zero(kMIN_BLOCK);
+    }
+
+    [[nodiscard]] static std::size_t block_size(const std::size_t cls) { return kMIN_BLOCK << cls; }
+
+    [[nodiscard]] static Block* to_block(const std::uint64_t head) {
+        return reinterpret_cast<Block*>(head & kPTR_MASK);
+    }
+
+    [[nodiscard]] static std::uint64_t next_head(const std::uint64_t head, Block* block) {
+        return ((head >> 48) + 1) << 48 | reinterpret_cast<std::uintptr_t>(block);
+    }
+
+    static Block* pop(FreeList& list) {
+        auto head = list.head_.load(std::memory_order::acquire);
+        while (Block* block = to_block(head)) {
+            // block may already belong to another thread, which may be writing to it; the tag
+            // makes the CAS fail in that case. The pool never hands chunk memory back while alive,
+            // so the read stays in bounds, and it is atomic so it does not race with push().
+            Block* next = std::atomic_ref(block->next_).load(std::memory_order::relaxed);
+            if (list.head_.compare_exchange_weak(head, next_head(head, next),
+                                                 std::memory_order::acquire,
+                                                 std::memory_order::acquire))
+                return block;
+        }
+        return nullptr;
+    }
+
+    static void push(FreeList& list, Block* first, Block* last) {
+        auto head = list.head_.load(std::memory_order::relaxed);
+        do {
+            std::atomic_ref(last->next_).store(to_block(head), std::memory_order::relaxed);
+        } while (!list.head_.compare_exchange_weak(head, next_head(head, first),
+                                                   std::memory_order::release,
+                                                   std::memory_order::relaxed));
+    }
+
+    Block* refill(const std::size_t cls) {
+        const std::size_t block = block_size(cls);
+        const std::size_t count = std::max<std::size_t>(16, kCHUNK_BYTES / block);
+        const std::size_t bytes = sizeof(Chunk) + count * block;
+
+        auto* chunk = static_cast<Chunk*>(upstream_->allocate(bytes, alignof(std::max_align_t)));
+        upstream_allocations_.fetch_add(1, std::memory_order::relaxed);
+        chunk->bytes_ = bytes;
+        chunk->next_ = chunks_.load(std::memory_order::relaxed);
+        while (!chunks_.compare_exchange_weak(chunk->next_, chunk, std::memory_order::release,
+                                              std::memory_order::relaxed)) {}
+
+        auto* base = reinterpret_cast<std::byte*>(chunk + 1);
+        auto at = [&](std::size_t i) { return reinterpret_cast<Block*>(base + i * block); };
+        for (std::size_t i = 1; i + 1 < count; ++i) at(i)->next_ = at(i + 1);
+        push(lists_[cls], at(1), at(count - 1));
+        return at(0);
+    }
+
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        if (bytes > kMAX_BLOCK || alignment > alignof(std::max_align_t))
+            return upstream_->allocate(bytes, alignment);
+        const auto cls = size_class(bytes);
+        if (Block* block = pop(lists_[cls])) return block;
+        return refill(cls);
+    }
+
+    void do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) override {
+        if (bytes > kMAX_BLOCK || alignment > alignof(std::max_align_t))
+            return upstream_->deallocate(p, bytes, alignment);
+        auto* block = static_cast<Block*>(p);
+        push(lists_[size_class(bytes)], block, block);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::array<FreeList, kCLASSES> lists_;
+    std::atomic<Chunk*> chunks_{nullptr};
+    std::atomic<std::uint64_t> upstream_allocations_{0};
+};
+
+namespace detail {
+struct NodePoolHolder {
+    NodePoolResource node_pool_;
+};
+}  // namespace detail
+
+/**
+ * @brief A std::pmr queue bundled with its own NodePoolResource
+ *
+ * The pool is a base so it is constructed before, and destroyed after, the queue using it.
+ */
+template <typename PmrQueue>
+class PooledQueue : private detail::NodePoolHolder, public PmrQueue {
+public:
+    PooledQueue() : PmrQueue(&this->node_pool_) {}
+
+    [[nodiscard]] const NodePoolResource& node_pool() const { return this->node_pool_; }
+};
+
+template <typename PmrQueue>
+struct max_producers<PooledQueue<PmrQueue>> : max_producers<PmrQueue> {};
+
+template <typename PmrQueue>
+struct max_consumers<PooledQueue<PmrQueue>> : max_consumers<PmrQueue> {};
+
+template <typename PmrQueue>
+struct is_blocking<PooledQueue<PmrQueue>> : is_blocking<PmrQueue> {};
+
+template <typename PmrQueue>
+struct is_lossy<PooledQueue<PmrQueue>> : is_lossy<PmrQueue> {};
+
+#endif  // NODEPOOL_H
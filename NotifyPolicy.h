@@ -0,0 +1,94 @@
+#ifndef NOTIFYPOLICY_H
+#define NOTIFYPOLICY_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct NotifyStats {
+    std::uint64_t notifications = 0;
+    std::uint64_t skipped = 0;
+
+    NotifyStats& operator+=(const NotifyStats& other) {
+        notifications += other.notifications;
+        skipped += other.skipped;
+        return *this;
+    }
+};
+
+/**
+ * Notification policies for the condition-variable queues.
+ *
+ * A policy is owned next to each condition variable and is only ever touched with the queue's
+ * lock held: wait() blocks until the predicate holds, should_notify() is called after making it
+ * true and says whether the caller should notify_one() once it has released the lock.
+ */
+
+// Notifies after every state change, whether or not anyone is waiting.
+class AlwaysNotify {
+public:
+    template <typename CondVar, typename Lock, typename Predicate>
+    void wait(CondVar& cv, Lock& lock, Predicate ready) {
+        cv.wait(lock, ready);
+    }
+
+    bool should_notify(bool /*transition*/) {
+        ++stats_.notifications;
+        return true;
+    }
+
+    [[nodiscard]] NotifyStats stats() const { return stats_; }
+
+private:
+    NotifyStats stats_;
+};
+
+// Counts sleeping waiters and the wakeups already sent to them, and only notifies while some
+// waiter is asleep without one on its way: on the transition the waiters are sleeping on (empty
+// to non-empty, full to non-full), or once every BATCH state changes otherwise. The changes in
+// between are not lost when there are several waiters, because a waiter leaving wait() passes a
+// wakeup on to the next sleeper that has none; pop() and push() return after one item, so the
+// waiter woken on the transition cannot be relied on to use them all.
+template <std::size_t BATCH>
+class BatchedNotify {
+    static_assert(BATCH > 0, "BATCH must be at least 1");
+
+public:
+    template <typename CondVar, typename Lock, typename Predicate>
+    void wait(CondVar& cv, Lock& lock, Predicate ready) {
+        while (!ready()) {
+            ++waiters_;
+            cv.wait(lock);
+            --waiters_;
+            if (signalled_ != 0) --signalled_;
+        }
+        if (waiters_ > signalled_) {
+            ++signalled_;
+            ++stats_.notifications;
+            cv.notify_one();
+        }
+    }
+
+    bool should_notify(const bool transition) {
+        if (waiters_ > signalled_ && (transition || ++pending_ >= BATCH)) {
+            pending_ = 0;
+            ++signalled_;
+            ++stats_.notifications;
+            return true;
+        }
+        if (waiters_ == 0) pending_ = 0;
+        ++stats_.skipped;
+        return false;
+    }
+
+    [[nodiscard]] NotifyStats stats() const { return stats_; }
+
+private:
+    std::size_t waiters_ = 0;
+    std::size_t signalled_ = 0;  // notified but not yet woken; never more than waiters_
+    std::size_t pending_ = 0;
+    NotifyStats stats_;
+};
+
+using NotifyWaiters = BatchedNotify<1>;
+
+#endif  // NOTIFYPOLICY_H
@@ -0,0 +1,11 @@
+#ifndef OVERFLOWPOLICY_H
+#define OVERFLOWPOLICY_H
+
+// What push() does when a bounded queue is full. try_push() always just fails instead.
+enum class OverflowPolicy {
+    Block,       // wait (or spin) until there is room
+    DropNewest,  // discard the item being pushed and return false
+    DropOldest,  // discard the oldest queued item to make room
+};
+
+#endif  // OVERFLOWPOLICY_H
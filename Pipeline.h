@@ -0,0 +1,243 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <emmintrin.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ThreadUtils.h"
+#include "alpha_spsc.h"
+
+namespace pipeline {
+
+constexpr unsigned kRING_SIZE = 4096;
+
+// Per-stage counters, written only by the stage's own thread and valid once join() returns.
+struct alignas(64) StageStats {
+    std::string name;
+    std::uint64_t processed = 0;
+    std::chrono::nanoseconds input_stall{0};   // waiting for the upstream ring to fill
+    std::chrono::nanoseconds output_stall{0};  // blocked by a full downstream ring
+    std::uint64_t occupancy_sum = 0;           // input ring size sampled at every pop
+
+    [[nodiscard]] double average_occupancy() const {
+        if (processed == 0) return 0.0;
+        return static_cast<double>(occupancy_sum) / static_cast<double>(processed);
+    }
+};
+
+// An SPSC ring plus the flag the writer sets once it will push nothing more.
+template <typename T>
+struct Channel {
+    alpha::spsc<T, kRING_SIZE> ring_;
+    std::atomic<bool> closed_{false};
+};
+
+namespace detail {
+
+// Spins briefly, then yields so stalled stages do not starve the others on shared cores.
+class Backoff {
+public:
+    void operator()() {
+        if (++spins_ < 64)
+            _mm_pause();
+        else
+            std::this_thread::yield();
+    }
+
+private:
+    unsigned spins_ = 0;
+};
+
+template <typename T>
+void send(Channel<T>& channel, const std::type_identity_t<T>& item,
+          std::chrono::nanoseconds& stall) {
+    if (channel.ring_.try_push(item)) return;
+    const auto start = std::chrono::steady_clock::now();
+    Backoff backoff;
+    while (!channel.ring_.try_push(item)) backoff();
+    stall += std::chrono::steady_clock::now() - start;
+}
+
+// Returns false once the writer has closed the channel and it is drained.
+template <typename T>
+bool receive(Channel<T>& channel, T& item, std::chrono::nanoseconds& stall) {
+    if (channel.ring_.try_pop(item)) return true;
+    const auto start = std::chrono::steady_clock::now();
+    Backoff backoff;
+    for (;;) {
+        if (channel.ring_.try_pop(item)) break;
+        if (channel.closed_.load(std::memory_order::acquire)) {
+            if (channel.ring_.try_pop(item)) break;
+            return false;
+        }
+        backoff();
+    }
+    stall += std::chrono::steady_clock::now() - start;
+    return true;
+}
+
+// Output type of the last of Stages, or In if there are none.
+template <typename In, typename... Stages>
+struct last_output {
+    using type = In;
+};
+
+template <typename In, typename First, typename... Rest>
+struct last_output<In, First, Rest...> : last_output<typename First::output_type, Rest...> {};
+
+}  // namespace detail
+
+template <typename In, typename F>
+struct Stage {
+    using input_type = In;
+    using output_type = std::invoke_result_t<F&, In>;
+
+    std::string name_;
+    F fn_;
+    int cpu_;
+};
+
+/**
+ * @brief Chain of single-threaded stages connected by alpha::spsc rings
+ *
+ * Each stage runs on its own thread, optionally pinned, and maps one input to one output. A full
+ * ring blocks the stage writing into it, so backpressure travels back to push(); close() marks
+ * the input finished and each stage closes its output after draining its input, so shutdown
+ * travels forward to pop(). push()/close() must be called from one producer thread and pop()
+ * from one consumer thread.
+ */
+template <typename In, typename... Stages>
+class Pipeline {
+    static constexpr std::size_t kSTAGES = sizeof...(Stages);
+    static_assert(kSTAGES > 0, "a pipeline needs at least one stage");
+
+public:
+    using input_type = In;
+    using output_type = typename detail::last_output<In, Stages...>::type;
+
+    explicit Pipeline(std::tuple<Stages...> stages)
+        : stages_(std::move(stages)),
+          channels_(std::make_unique<Channel<In>>(),
+                    std::make_unique<Channel<typename Stages::output_type>>()...) {
+        std::apply([&](const auto&... stage) {
+            std::size_t i = 0;
+            ((stats_[i++].name = stage.name_), ...);
+        }, stages_);
+    }
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // Closes the input and discards unconsumed output so that stages blocked on a full ring can
+    // finish; close() and a drained pop() are both safe to repeat after an explicit shutdown.
+    ~Pipeline() {
+        if (threads_.empty()) return;
+        close();
+        for (output_type item; pop(item);) {
+        }
+        for (auto& thread : threads_)
+            if (thread.joinable()) thread.join();
+    }
+
+    void start() { start(std::make_index_sequence<kSTAGES>{}); }
+
+    void push(const In& item) { detail::send(*std::get<0>(channels_), item, source_stall_); }
+
+    void close() { std::get<0>(channels_)->closed_.store(true, std::memory_order::release); }
+
+    // Blocks for the next output; false once the pipeline is closed and drained.
+    bool pop(output_type& item) {
+        return detail::receive(*std::get<kSTAGES>(channels_), item, sink_stall_);
+    }
+
+    void join() {
+        for (auto& thread : threads_) thread.join();
+    }
+
+    [[nodiscard]] const std::array<StageStats, kSTAGES>& stats() const { return stats_; }
+
+    // Time push() spent blocked by backpressure and pop() spent waiting for output.
+    [[nodiscard]] std::chrono::nanoseconds source_stall() const { return source_stall_; }
+    [[nodiscard]] std::chrono::nanoseconds sink_stall() const { return sink_stall_; }
+
+private:
+    template <std::size_t... I>
+    void start(std::index_sequence<I...>) {
+        (threads_.emplace_back([this] { run_stage<I>(); }), ...);
+    }
+
+    template <std::size_t I>
+    void run_stage() {
+        auto& stage = std::get<I>(stages_);
+        auto& in = *std::get<I>(channels_);
+        auto& out = *std::get<I + 1>(channels_);
+        auto& stats = stats_[I];
+        pinThread(stage.cpu_);
+
+        typename std::tuple_element_t<I, std::tuple<Stages...>>::input_type item;
+        while (detail::receive(in, item, stats.input_stall)) {
+            stats.occupancy_sum += in.ring_.size() + 1;
+            detail::send(out, stage.fn_(std::move(item)), stats.output_stall);
+            ++stats.processed;
+        }
+        out.closed_.store(true, std::memory_order::release);
+    }
+
+    std::tuple<Stages...> stages_;
+    std::tuple<std::unique_ptr<Channel<In>>,
+               std::unique_ptr<Channel<typename Stages::output_type>>...> channels_;
+    std::array<StageStats, kSTAGES> stats_;
+    std::vector<std::thread> threads_;
+    std::chrono::nanoseconds source_stall_{0};
+    std::chrono::nanoseconds sink_stall_{0};
+};
+
+/**
+ * @brief Builds a Pipeline one typed stage at a time
+ *
+ *     auto p = pipeline::Builder<Raw>{}
+ *                  .stage("parse", parse, 1)
+ *                  .stage("enrich", enrich, 2)
+ *                  .build();
+ *
+ * Each stage's input type is the previous stage's output type, so a mismatch is a compile error.
+ * cpu is the core to pin the stage to, or -1 to leave it unpinned.
+ */
+template <typename In, typename... Stages>
+class Builder {
+public:
+    using output_type = typename detail::last_output<In, Stages...>::type;
+
+    Builder() = default;
+    explicit Builder(std::tuple<Stages...> stages) : stages_(std::move(stages)) {}
+
+    template <typename F>
+    [[nodiscard]] auto stage(std::string name, F fn, const int cpu = -1) && {
+        using Next = Stage<output_type, F>;
+        return Builder<In, Stages..., Next>(std::tuple_cat(
+            std::move(stages_), std::tuple<Next>(Next{std::move(name), std::move(fn), cpu})));
+    }
+
+    [[nodiscard]] std::unique_ptr<Pipeline<In, Stages...>> build() && {
+        return std::make_unique<Pipeline<In, Stages...>>(std::move(stages_));
+    }
+
+private:
+    std::tuple<Stages...> stages_;
+};
+
+}  // namespace pipeline
+
+#endif  // PIPELINE_H
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "Pipeline.h"
+
+class PipelineTest : public testing::Test {};
+
+TEST_F(PipelineTest, TransformsInOrderTest) {
+    constexpr int kITEMS = 20'000;
+    auto p = pipeline::Builder<int>{}
+                 .stage("double", [](int x) { return 2L * x; })
+                 .stage("offset", [](long x) { return x + 1; })
+                 .stage("narrow", [](long x) { return static_cast<unsigned>(x); })
+                 .build();
+    static_assert(std::is_same_v<decltype(p)::element_type::output_type, unsigned>);
+    p->start();
+
+    std::thread producer([&] {
+        for (int i = 0; i < kITEMS; ++i) p->push(i);
+        p->close();
+    });
+
+    unsigned out;
+    int expected = 0;
+    while (p->pop(out)) {
+        EXPECT_EQ(out, static_cast<unsigned>(2 * expected + 1));
+        ++expected;
+    }
+    producer.join();
+    p->join();
+
+    EXPECT_EQ(expected, kITEMS);
+    for (const auto& stats : p->stats()) EXPECT_EQ(stats.processed, static_cast<unsigned>(kITEMS));
+    EXPECT_EQ(p->stats()[1].name, "offset");
+}
+
+TEST_F(PipelineTest, BackpressureFromSlowSinkTest) {
+    constexpr int kITEMS = 3 * pipeline::kRING_SIZE;
+    auto p = pipeline::Builder<int>{}.stage("identity", [](int x) { return x; }).build();
+    p->start();
+
+    std::thread producer([&] {
+        for (int i = 0; i < kITEMS; ++i) p->push(i);
+        p->close();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    int out;
+    long long sum = 0;
+    while (p->pop(out)) sum += out;
+    producer.join();
+    p->join();
+
+    EXPECT_EQ(sum, static_cast<long long>(kITEMS) * (kITEMS - 1) / 2);
+    EXPECT_GT(p->stats()[0].output_stall.count(), 0);
+}
+
+TEST_F(PipelineTest, CloseWithoutInputTest) {
+    auto p = pipeline::Builder<int>{}
+                 .stage("a", [](int x) { return x; })
+                 .stage("b", [](int x) { return x; })
+                 .build();
+    p->start();
+    p->close();
+    int out;
+    EXPECT_FALSE(p->pop(out));
+    p->join();
+}
+
+TEST_F(PipelineTest, DestroyWithoutCloseTest) {
+    constexpr int kITEMS = 2 * pipeline::kRING_SIZE;
+    auto p = pipeline::Builder<int>{}
+                 .stage("a", [](int x) { return x; })
+                 .stage("b", [](int x) { return x; })
+                 .build();
+    p->start();
+    for (int i = 0; i < kITEMS; ++i) p->push(i);
+    p.reset();  // neither closed nor drained: must not hang
+}
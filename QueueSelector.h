@@ -0,0 +1,156 @@
+#ifndef QUEUESELECTOR_H
+#define QUEUESELECTOR_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "Futex.h"
+#include "QueueTypeTraits.h"
+
+/**
+ * @brief Lets one consumer wait on any of up to N queues
+ *
+ * Queues set their bit in the ready bitmap when they go from empty to non-empty. select() takes
+ * the whole bitmap, visits the set bits with std::countr_zero and parks on a single futex when
+ * no bit is set, so empty queues are never looked at. Only the consumer thread may call select()
+ * or poll().
+ */
+template <std::size_t N = 64>
+class QueueSelector {
+    static constexpr std::size_t kWORDS = (N + 63) / 64;
+
+public:
+    static constexpr std::size_t capacity() { return N; }
+
+    // Marks queue index as ready and wakes the consumer if it is parked.
+    void notify(const std::size_t index) {
+        const std::uint64_t bit = std::uint64_t{1} << (index % 64);
+        if (ready_[index / 64].fetch_or(bit, std::memory_order::seq_cst) & bit) return;
+        if (parked_.load(std::memory_order::seq_cst) &&
+            parked_.exchange(0, std::memory_order::relaxed))
+            futex_wake(parked_);
+    }
+
+    // Calls on_ready(index) for every queue marked ready since the last call and returns how many
+    // there were. The handler should drain its queue; if it leaves items behind it must notify()
+    // the index again.
+    template <typename Handler>
+    std::size_t poll(Handler&& on_ready) {
+        std::size_t count = 0;
+        for (std::size_t word = 0; word < kWORDS; ++word) {
+            if (ready_[word].load(std::memory_order::relaxed) == 0) continue;
+            auto bits = ready_[word].exchange(0, std::memory_order::acquire);
+            count += std::popcount(bits);
+            while (bits) {
+                on_ready(word * 64 + std::countr_zero(bits));
+                bits &= bits - 1;
+            }
+        }
+        return count;
+    }
+
+    // Like poll(), but parks until at least one queue is ready.
+    template <typename Handler>
+    std::size_t select(Handler&& on_ready) {
+        for (;;) {
+            if (const auto count = poll(on_ready)) return count;
+            parked_.store(1, std::memory_order::seq_cst);
+            if (!any_ready()) {
+                futex_wait(parked_, 1);
+                parks_.fetch_add(1, std::memory_order::relaxed);
+            }
+            parked_.store(0, std::memory_order::relaxed);
+        }
+    }
+
+    // Number of times select() had to park on the futex.
+    [[nodiscard]] std::uint64_t parks() const { return parks_.load(std::memory_order::relaxed); }
+
+private:
+    [[nodiscard]] bool any_ready() const {
+        for (const auto& word : ready_)
+            if (word.load(std::memory_order::seq_cst)) return true;
+        return false;
+    }
+
+    std::array<std::atomic<std::uint64_t>, kWORDS> ready_{};
+    alignas(64) std::atomic<std::uint32_t> parked_{0};
+    std::atomic<std::uint64_t> parks_{0};
+};
+
+/**
+ * @brief A queue that reports its empty to non-empty transitions to a QueueSelector
+ *
+ * Same arming scheme as NotifyingQueue: the consumer arms the queue when try_pop() finds it
+ * empty, and only the first push after that notifies the selector, so a producer feeding a queue
+ * that is still being drained touches nothing shared beyond the queue itself.
+ */
+template <typename Queue, std::size_t N = 64>
+class SelectableQueue : public Queue {
+public:
+    using value_type = typename Queue::value_type;
+
+    template <typename... Args>
+    SelectableQueue(QueueSelector<N>& selector, const std::size_t index, Args&&... args)
+        : Queue(std::forward<Args>(args)...), selector_(selector), index_(index) {}
+
+    bool push(const value_type& item) {
+        if (!Queue::push(item)) return false;
+        signal();
+        return true;
+    }
+
+    bool try_push(const value_type& item) {
+        if (!Queue::try_push(item)) return false;
+        signal();
+        return true;
+    }
+
+    bool try_pop(value_type& item) {
+        if (Queue::try_pop(item)) return true;
+        armed_.store(true, std::memory_order::relaxed);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (!Queue::try_pop(item)) return false;
+        armed_.store(false, std::memory_order::relaxed);
+        return true;
+    }
+
+    [[nodiscard]] std::size_t index() const { return index_; }
+
+private:
+    void signal() {
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (armed_.load(std::memory_order::relaxed) &&
+            armed_.exchange(false, std::memory_order::relaxed))
+            selector_.notify(index_);
+    }
+
+    QueueSelector<N>& selector_;
+    const std::size_t index_;
+    alignas(64) std::atomic<bool> armed_{true};
+};
+
+template <typename Queue, std::size_t N>
+struct is_bounded<SelectableQueue<Queue, N>> : is_bounded<Queue> {};
+
+template <typename Queue, std::size_t N>
+struct max_producers<SelectableQueue<Queue, N>> : max_producers<Queue> {};
+
+template <typename Queue, std::size_t N>
+struct max_consumers<SelectableQueue<Queue, N>> : max_consumers<Queue> {};
+
+template <typename Queue, std::size_t N>
+struct is_blocking<SelectableQueue<Queue, N>> : is_blocking<Queue> {};
+
+template <typename Queue, std::size_t N>
+struct is_lossy<SelectableQueue<Queue, N>> : is_lossy<Queue> {};
+
+// As with NotifyingQueue, the inherited try_pop_bulk() would skip arming.
+template <typename Queue, std::size_t N>
+struct supports_batch<SelectableQueue<Queue, N>> : std::false_type {};
+
+#endif  // QUEUESELECTOR_H
@@ -1,12 +1,63 @@
 #ifndef QUEUETYPETRAITS_H
 #define QUEUETYPETRAITS_H
 
+#include <concepts>
+#include <cstddef>
+#include <limits>
 #include <type_traits>
 
+// Constructed with a runtime capacity, e.g. Queue(16384).
 template<typename T>
 struct is_bounded : std::false_type {};
 
 template<typename T>
 constexpr bool is_bounded_v = is_bounded<T>::value;
 
+/**
+ * Capability traits used to decide which benchmarks and tests a queue may take part in.
+ *
+ * The defaults describe a general MPMC queue that spins in pop(), never discards items and has
+ * no batch interface; queues that differ specialise the trait next to their definition.
+ */
+constexpr unsigned kUNLIMITED_THREADS = std::numeric_limits<unsigned>::max();
+
+// How many threads may call push() / pop() concurrently.
+template<typename T>
+struct max_producers : std::integral_constant<unsigned, kUNLIMITED_THREADS> {};
+
+template<typename T>
+constexpr unsigned max_producers_v = max_producers<T>::value;
+
+template<typename T>
+struct max_consumers : std::integral_constant<unsigned, kUNLIMITED_THREADS> {};
+
+template<typename T>
+constexpr unsigned max_consumers_v = max_consumers<T>::value;
+
+// pop() (and push() when full) sleeps on a condition variable or futex instead of spinning, so
+// oversubscribing the cores with waiting threads is cheap.
+template<typename T>
+struct is_blocking : std::false_type {};
+
+template<typename T>
+constexpr bool is_blocking_v = is_blocking<T>::value;
+
+// push() may discard items (a drop policy, or conflation), so consumers can't count on seeing
+// everything that was pushed.
+template<typename T>
+struct is_lossy : std::false_type {};
+
+template<typename T>
+constexpr bool is_lossy_v = is_lossy<T>::value;
+
+// Has a try_pop_bulk(out, max) that moves several items per call; detected rather than declared.
+template<typename T>
+struct supports_batch
+    : std::bool_constant<requires(T& queue, typename T::value_type* out) {
+          { queue.try_pop_bulk(out, std::size_t{1}) } -> std::convertible_to<std::size_t>;
+      }> {};
+
+template<typename T>
+constexpr bool supports_batch_v = supports_batch<T>::value;
+
 #endif //QUEUETYPETRAITS_H
@@ -1,6 +1,7 @@
 #ifndef RIGTORP_QUEUE_ADAPTERS_H
 #define RIGTORP_QUEUE_ADAPTERS_H
 
+#include "ConcurrentQueueConcept.h"
 #include "QueueTypeTraits.h"
 #include "rigtorp/SPSCQueue.h"
 #include <emmintrin.h>
@@ -12,15 +13,28 @@ public:
 
     RigtorpSPSCAdapter(const size_t capacity) : queue_(capacity) {}
 
-    void push(const T& item) {
+    bool push(const T& item) {
         queue_.push(item);
+        return true;
     }
 
-    void pop(T& item) {
-        while (!queue_.front())
+    bool try_push(const T& item) {
+        return queue_.try_push(item);
+    }
+
+    bool pop(T& item) {
+        while (!try_pop(item))
             _mm_pause();
-        item = *queue_.front();
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        T* front = queue_.front();
+        if (!front)
+            return false;
+        item = *front;
         queue_.pop();
+        return true;
     }
 
 private:
@@ -30,4 +44,13 @@ private:
 template<typename T>
 struct is_bounded<RigtorpSPSCAdapter<T>> : std::true_type {};
 
+template<typename T>
+struct max_producers<RigtorpSPSCAdapter<T>> : std::integral_constant<unsigned, 1> {};
+
+template<typename T>
+struct max_consumers<RigtorpSPSCAdapter<T>> : std::integral_constant<unsigned, 1> {};
+
+static_assert(SpscQueue<RigtorpSPSCAdapter<int>>,
+              "RigtorpSPSCAdapter does not satisfy the SpscQueue concept");
+
 #endif //RIGTORP_QUEUE_ADAPTERS_H
@@ -1,8 +1,11 @@
 #ifndef RINGBUFFER_H
 #define RINGBUFFER_H
 
+#include <algorithm>
 #include <vector>
 
+#include "SimdCopy.h"
+
 template<typename T>
 class RingBuffer {
 public:
@@ -28,12 +31,32 @@ public:
         --size_;
     }
 
+    // Appends count items in at most two contiguous copies, vectorised for trivially copyable T.
+    // Unlike push_back() it never overwrites: count must not exceed capacity() - size().
+    void push_back_bulk(const T* items, const std::size_t count,
+                        const simd::StoreHint hint = simd::StoreHint::Cached) {
+        const auto first = std::min(count, capacity() - tail_);
+        simd::copy_items(buffer_.data() + tail_, items, first, hint);
+        simd::copy_items(buffer_.data(), items + first, count - first, hint);
+        tail_ = (tail_ + count) % capacity();
+        size_ += count;
+    }
+
+    // Moves the count oldest items to out; count must not exceed size().
+    void pop_front_bulk(T* out, const std::size_t count) {
+        const auto first = std::min(count, capacity() - head_);
+        simd::move_items(out, buffer_.data() + head_, first);
+        simd::move_items(out + first, buffer_.data(), count - first);
+        head_ = (head_ + count) % capacity();
+        size_ -= count;
+    }
+
     [[nodiscard]] std::size_t size() const { return size_; }
     [[nodiscard]] bool empty() const { return size_ == 0; }
     [[nodiscard]] bool full() const { return size_ == capacity(); }
+    [[nodiscard]] std::size_t capacity() const { return buffer_.size(); }
 
 private:
-    [[nodiscard]] std::size_t capacity() const { return buffer_.size(); }
 
     std::vector<T> buffer_;
     std::size_t head_ = 0;
@@ -0,0 +1,87 @@
+#ifndef SEQLOCKSLOT_H
+#define SEQLOCKSLOT_H
+
+#include <emmintrin.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "CacheLine.h"
+
+/**
+ * @brief Single-writer, multi-reader slot holding only the latest value
+ *
+ * The writer bumps the sequence to odd, writes the value and bumps it back to even, so store()
+ * never waits for readers. A reader copies the value between two reads of the sequence and
+ * retries if the sequence was odd or changed, i.e. if it may have seen a torn write. The value
+ * lives in relaxed atomic words so the racing copy is well defined; the sequence and value share
+ * the slot's cache lines and the slot is padded so nothing else does.
+ */
+template <typename T>
+class SeqlockSlot {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockSlot copies T word by word");
+
+    static constexpr std::size_t kWORDS =
+        (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    using Words = std::array<std::uint64_t, kWORDS>;
+
+public:
+    using value_type = T;
+
+    SeqlockSlot() = default;
+    explicit SeqlockSlot(const T& initial) { store(initial); }
+
+    SeqlockSlot(const SeqlockSlot&) = delete;
+    SeqlockSlot& operator=(const SeqlockSlot&) = delete;
+
+    // Writer only.
+    void store(const T& value) {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const auto seq = seq_.load(std::memory_order::relaxed);
+        seq_.store(seq + 1, std::memory_order::relaxed);
+        std::atomic_thread_fence(std::memory_order::release);
+        for (std::size_t i = 0; i < kWORDS; ++i)
+            words_[i].store(words[i], std::memory_order::relaxed);
+        seq_.store(seq + 2, std::memory_order::release);
+    }
+
+    // Copies the latest complete value into out and returns its version (0 until the first
+    // store, then 1, 2, ...). retries, if given, is incremented for every torn read.
+    std::uint64_t load(T& out, std::uint64_t* retries = nullptr) const {
+        Words words;
+        for (;;) {
+            const auto before = seq_.load(std::memory_order::acquire);
+            if (before & 1) {
+                _mm_pause();
+                continue;
+            }
+            for (std::size_t i = 0; i < kWORDS; ++i)
+                words[i] = words_[i].load(std::memory_order::relaxed);
+            std::atomic_thread_fence(std::memory_order::acquire);
+            if (seq_.load(std::memory_order::relaxed) == before) {
+                std::memcpy(static_cast<void*>(&out), words.data(), sizeof(T));
+                return before / 2;
+            }
+            if (retries) ++*retries;
+        }
+    }
+
+    // Version of the latest value, for readers polling for a change before paying for load().
+    [[nodiscard]] std::uint64_t version() const {
+        return seq_.load(std::memory_order::acquire) / 2;
+    }
+
+private:
+    static constexpr std::size_t kUSED = sizeof(std::atomic<std::uint64_t>) * (kWORDS + 1);
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> seq_{0};
+    std::array<std::atomic<std::uint64_t>, kWORDS> words_{};
+    char padding_[CACHE_LINE_SIZE - kUSED % CACHE_LINE_SIZE];
+};
+
+#endif  // SEQLOCKSLOT_H
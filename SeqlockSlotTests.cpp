@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "SeqlockSlot.h"
+
+class SeqlockSlotTest : public testing::Test {};
+
+TEST_F(SeqlockSlotTest, LoadsLatestValueTest) {
+    SeqlockSlot<int> slot;
+    int out = -1;
+    EXPECT_EQ(slot.load(out), 0);
+    EXPECT_EQ(out, 0);
+
+    slot.store(5);
+    slot.store(7);
+    EXPECT_EQ(slot.version(), 2);
+    EXPECT_EQ(slot.load(out), 2);
+    EXPECT_EQ(out, 7);
+}
+
+TEST_F(SeqlockSlotTest, ReadersNeverSeeTornValuesTest) {
+    using Snapshot = std::array<std::uint64_t, 12>;
+    constexpr std::uint64_t kUPDATES = 200'000;
+    SeqlockSlot<Snapshot> slot;
+    std::atomic<bool> done = false;
+    std::atomic<int> torn = 0;
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            Snapshot snapshot;
+            std::uint64_t last_version = 0;
+            while (!done.load(std::memory_order::relaxed)) {
+                const auto version = slot.load(snapshot);
+                for (const auto word : snapshot)
+                    if (word != snapshot[0]) ++torn;
+                if (version < last_version || snapshot[0] != version) ++torn;
+                last_version = version;
+            }
+        });
+    }
+
+    Snapshot snapshot;
+    for (std::uint64_t n = 1; n <= kUPDATES; ++n) {
+        snapshot.fill(n);
+        slot.store(snapshot);
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+    EXPECT_EQ(torn, 0);
+}
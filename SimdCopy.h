@@ -0,0 +1,158 @@
+#ifndef SIMDCOPY_H
+#define SIMDCOPY_H
+
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Vectorised bulk copies for moving batches of small trivially copyable items
+ *
+ * copy_bytes() picks the widest path the CPU supports the first time it is called (AVX2, then
+ * SSE2, then 8-byte scalar words) and calls it through a function pointer from then on, so the
+ * binary needs no -mavx2 and still runs on older hardware. The vector kernels are compiled for
+ * their instruction set with target attributes.
+ *
+ * StoreHint::NonTemporal writes the destination with streaming stores that bypass the cache.
+ * That only pays off for batches much larger than the last-level cache whose destination the
+ * writing thread will not read again; for anything else it is slower.
+ */
+namespace simd {
+
+enum class StoreHint { Cached, NonTemporal };
+
+using CopyFn = void (*)(void* dst, const void* src, std::size_t bytes, StoreHint hint);
+
+// Word-at-a-time baseline. The empty asm keeps the compiler from vectorising the loop or turning
+// it back into memcpy, so it measures what a per-element copy costs.
+inline void copy_scalar(void* dst, const void* src, std::size_t bytes, StoreHint = {}) {
+    auto* d = static_cast<std::byte*>(dst);
+    const auto* s = static_cast<const std::byte*>(src);
+    for (; bytes >= 8; bytes -= 8, d += 8, s += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, s, 8);
+        asm volatile("" : "+r"(word));
+        std::memcpy(d, &word, 8);
+    }
+    for (; bytes; --bytes) *d++ = *s++;
+}
+
+[[gnu::target("sse2")]] inline void copy_sse2(void* dst, const void* src, std::size_t bytes,
+                                              const StoreHint hint = StoreHint::Cached) {
+    auto* d = static_cast<std::byte*>(dst);
+    const auto* s = static_cast<const std::byte*>(src);
+    if (hint == StoreHint::NonTemporal && bytes >= 64) {
+        // One unaligned vector covers the head; stream from the next aligned address on.
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+        const std::size_t head = 16 - (reinterpret_cast<std::uintptr_t>(d) & 15);
+        d += head, s += head, bytes -= head;
+        for (; bytes >= 16; bytes -= 16, d += 16, s += 16)
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+        _mm_sfence();
+    }
+    for (; bytes >= 64; bytes -= 64, d += 64, s += 64) {
+        const auto* from = reinterpret_cast<const __m128i*>(s);
+        auto* to = reinterpret_cast<__m128i*>(d);
+        const __m128i a = _mm_loadu_si128(from);
+        const __m128i b = _mm_loadu_si128(from + 1);
+        const __m128i c = _mm_loadu_si128(from + 2);
+        const __m128i e = _mm_loadu_si128(from + 3);
+        _mm_storeu_si128(to, a);
+        _mm_storeu_si128(to + 1, b);
+        _mm_storeu_si128(to + 2, c);
+        _mm_storeu_si128(to + 3, e);
+    }
+    for (; bytes >= 16; bytes -= 16, d += 16, s += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+    copy_scalar(d, s, bytes);
+}
+
+[[gnu::target("avx2")]] inline void copy_avx2(void* dst, const void* src, std::size_t bytes,
+                                              const StoreHint hint = StoreHint::Cached) {
+    auto* d = static_cast<std::byte*>(dst);
+    const auto* s = static_cast<const std::byte*>(src);
+    if (hint == StoreHint::NonTemporal && bytes >= 128) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+        const std::size_t head = 32 - (reinterpret_cast<std::uintptr_t>(d) & 31);
+        d += head, s += head, bytes -= head;
+        for (; bytes >= 32; bytes -= 32, d += 32, s += 32)
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+        _mm_sfence();
+    }
+    for (; bytes >= 128; bytes -= 128, d += 128, s += 128) {
+        const auto* from = reinterpret_cast<const __m256i*>(s);
+        auto* to = reinterpret_cast<__m256i*>(d);
+        const __m256i a = _mm256_loadu_si256(from);
+        const __m256i b = _mm256_loadu_si256(from + 1);
+        const __m256i c = _mm256_loadu_si256(from + 2);
+        const __m256i e = _mm256_loadu_si256(from + 3);
+        _mm256_storeu_si256(to, a);
+        _mm256_storeu_si256(to + 1, b);
+        _mm256_storeu_si256(to + 2, c);
+        _mm256_storeu_si256(to + 3, e);
+    }
+    for (; bytes >= 32; bytes -= 32, d += 32, s += 32)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+    copy_sse2(d, s, bytes);
+}
+
+inline CopyFn resolve_copy() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &copy_avx2;
+    if (__builtin_cpu_supports("sse2")) return &copy_sse2;
+    return &copy_scalar;
+}
+
+// Resolved on first use rather than during static initialisation, so copies made from other
+// static initialisers are safe.
+[[nodiscard]] inline CopyFn active_copy() {
+    static const CopyFn copy = resolve_copy();
+    return copy;
+}
+
+[[nodiscard]] inline char const* copy_path_name() {
+    if (active_copy() == &copy_avx2) return "AVX2";
+    if (active_copy() == &copy_sse2) return "SSE2";
+    return "scalar";
+}
+
+inline void copy_bytes(void* dst, const void* src, const std::size_t bytes,
+                       const StoreHint hint = StoreHint::Cached) {
+    active_copy()(dst, src, bytes, hint);
+}
+
+// Copies count items, vectorised for trivially copyable T and element by element otherwise.
+template <typename T>
+void copy_items(T* dst, const T* src, const std::size_t count,
+                const StoreHint hint = StoreHint::Cached) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        copy_bytes(dst, src, count * sizeof(T), hint);
+    } else {
+        for (std::size_t i = 0; i < count; ++i) dst[i] = src[i];
+    }
+}
+
+// As copy_items, but moves non-trivially copyable items out of src.
+template <typename T>
+void move_items(T* dst, T* src, const std::size_t count,
+                const StoreHint hint = StoreHint::Cached) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        copy_bytes(dst, src, count * sizeof(T), hint);
+    } else {
+        for (std::size_t i = 0; i < count; ++i) dst[i] = std::move(src[i]);
+    }
+}
+
+}  // namespace simd
+
+#endif  // SIMDCOPY_H
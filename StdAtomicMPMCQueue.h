@@ -2,16 +2,37 @@
 #define STDATOMICMPMCQUEUE_H
 
 #include <atomic>
+#include <cstdint>
 
-template <typename T, std::size_t SIZE>
+#include "ConcurrentQueueConcept.h"
+#include "OverflowPolicy.h"
+#include "QueueTypeTraits.h"
+
+// POLICY picks what push() does when the queue is full; DropOldest pops and discards the oldest
+// item to make room, racing fairly with the consumers.
+template <typename T, std::size_t SIZE, OverflowPolicy POLICY = OverflowPolicy::Block>
 class StdAtomicMPMCQueue {
 public:
+    using value_type = T;
+
     StdAtomicMPMCQueue() {
         for (size_t i = 0; i < SIZE; ++i)
             buffer_[i].seq_.store(i, std::memory_order_relaxed);
     }
 
     bool push(const T& item) {
+        if constexpr (POLICY == OverflowPolicy::DropNewest) {
+            if (try_push(item)) return true;
+            dropped_.fetch_add(1, std::memory_order::relaxed);
+            return false;
+        } else if constexpr (POLICY == OverflowPolicy::DropOldest) {
+            T discarded;
+            while (!try_push(item)) {
+                if (try_pop(discarded)) dropped_.fetch_add(1, std::memory_order::relaxed);
+            }
+            return true;
+        }
+
         node_t* pNode = nullptr;
         auto write_idx = write_idx_.load(std::memory_order::relaxed);
 
@@ -31,6 +52,30 @@ public:
         return true;
     }
 
+    bool try_push(const T& item) {
+        node_t* pNode = nullptr;
+        auto write_idx = write_idx_.load(std::memory_order::relaxed);
+
+        for (;;) {
+            pNode = &buffer_[write_idx % SIZE];
+            auto seq = pNode->seq_.load(std::memory_order::acquire);
+            const auto dif =
+                static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(write_idx);
+            if (dif == 0) {
+                if (write_idx_.compare_exchange_weak(write_idx, write_idx + 1,
+                                                     std::memory_order::relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                write_idx = write_idx_.load(std::memory_order::relaxed);
+            }
+        }
+        pNode->data_ = item;
+        pNode->seq_.store(write_idx + 1, std::memory_order::release);
+        return true;
+    }
+
     bool pop(T& item) {
         node_t* pNode = nullptr;
         auto read_idx = read_idx_.load(std::memory_order::relaxed);
@@ -52,6 +97,36 @@ public:
         return true;
     }
 
+    bool try_pop(T& item) {
+        node_t* pNode = nullptr;
+        auto read_idx = read_idx_.load(std::memory_order::relaxed);
+
+        for (;;) {
+            pNode = &buffer_[read_idx % SIZE];
+            auto seq = pNode->seq_.load(std::memory_order::acquire);
+            const auto dif =
+                static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(read_idx + 1);
+            if (dif == 0) {
+                if (read_idx_.compare_exchange_weak(read_idx, read_idx + 1,
+                                                    std::memory_order::relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                read_idx = read_idx_.load(std::memory_order::relaxed);
+            }
+        }
+
+        item = pNode->data_;
+        pNode->seq_.store(read_idx + SIZE, std::memory_order::release);
+        return true;
+    }
+
+    // Items discarded by push() under a drop policy.
+    [[nodiscard]] std::uint64_t dropped() const {
+        return dropped_.load(std::memory_order::relaxed);
+    }
+
 private:
     struct alignas(64) node_t {
         std::atomic<std::size_t> seq_{0};
@@ -69,8 +144,16 @@ private:
     node_t buffer_[SIZE];
     std::atomic<std::size_t> write_idx_{0};
     std::atomic<std::size_t> read_idx_{0};
+    std::atomic<std::uint64_t> dropped_{0};
 };
 
+template <typename T, std::size_t SIZE, OverflowPolicy POLICY>
+struct is_lossy<StdAtomicMPMCQueue<T, SIZE, POLICY>>
+    : std::bool_constant<POLICY != OverflowPolicy::Block> {};
+
+static_assert(ConcurrentQueue<StdAtomicMPMCQueue<int, 4>>,
+              "StdAtomicMPMCQueue does not satisfy the ConcurrentQueue concept");
+
 template <typename T>
 class mpmc_bounded_queue {
 public:
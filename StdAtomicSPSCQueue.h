@@ -2,38 +2,50 @@
 #define STD_ATOMIC_SPSC_QUEUE_H
 
 #include <atomic>
+#include <cstddef>
+
+#include "ConcurrentQueueConcept.h"
+#include "QueueTypeTraits.h"
 
 template <typename T, std::size_t SIZE>
 class StdAtomicSPSCQueue {
 public:
+    using value_type = T;
+
     bool push(const T& item) {
-        auto tail = tail_.load(std::memory_order::relaxed);
-        for (;;) {
+        while (!try_push(item)) {}
+        return true;
+    }
+
+    bool try_push(const T& item) {
+        const auto tail = tail_.load(std::memory_order::relaxed);
+        if (full(tail, cached_head_)) {
+            cached_head_ = head_.load(std::memory_order::acquire);
             if (full(tail, cached_head_)) {
-                cached_head_ = head_.load(std::memory_order::acquire);
-                if (full(tail, cached_head_)) {
-                    continue;
-                }
+                return false;
             }
-            new (&buffer_[tail % SIZE].data_) T(item);
-            tail_.store(tail + 1, std::memory_order::release);
-            return true;
         }
+        new (&buffer_[tail % SIZE].data_) T(item);
+        tail_.store(tail + 1, std::memory_order::release);
+        return true;
     }
 
     bool pop(T& item) {
-        auto head = head_.load(std::memory_order::relaxed);
-        for (;;) {
+        while (!try_pop(item)) {}
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        const auto head = head_.load(std::memory_order::relaxed);
+        if (empty(cached_tail_, head)) {
+            cached_tail_ = tail_.load(std::memory_order::acquire);
             if (empty(cached_tail_, head)) {
-                cached_tail_ = tail_.load(std::memory_order::acquire);
-                if (empty(cached_tail_, head)) {
-                    continue;
-                }
+                return false;
             }
-            item = buffer_[head % SIZE].data_;
-            head_.store(head + 1, std::memory_order::release);
-            return true;
         }
+        item = buffer_[head % SIZE].data_;
+        head_.store(head + 1, std::memory_order::release);
+        return true;
     }
 
 private:
@@ -56,4 +68,13 @@ private:
     alignas(64) std::size_t cached_tail_{0};
 };
 
+template <typename T, std::size_t SIZE>
+struct max_producers<StdAtomicSPSCQueue<T, SIZE>> : std::integral_constant<unsigned, 1> {};
+
+template <typename T, std::size_t SIZE>
+struct max_consumers<StdAtomicSPSCQueue<T, SIZE>> : std::integral_constant<unsigned, 1> {};
+
+static_assert(SpscQueue<StdAtomicSPSCQueue<int, 1024>>,
+              "StdAtomicSPSCQueue does not satisfy the SpscQueue concept");
+
 #endif  // STD_ATOMIC_SPSC_QUEUE_H
@@ -0,0 +1,28 @@
+#ifndef THREADUTILS_H
+#define THREADUTILS_H
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Pins the calling thread to cpu; a negative cpu leaves the thread unpinned.
+inline void pinThread(int cpu) {
+    if (cpu < 0) {
+        return;
+    }
+    ::cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    // Returns the error number rather than setting errno. Exiting keeps a placement from being
+    // reported for threads that were never pinned.
+    if (const int rc = ::pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+        rc != 0) {
+        std::fprintf(stderr, "pthread_setaffinity_np(cpu %d): %s\n", cpu, std::strerror(rc));
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+#endif  // THREADUTILS_H
@@ -0,0 +1,68 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "CacheLine.h"
+
+/**
+ * @brief Lock-free single-producer, single-consumer handoff of the newest state
+ *
+ * Three buffers: the writer owns one, the reader owns one and the third is parked in state_
+ * together with a "fresh" bit. publish() swaps the writer's buffer into state_ and acquire()
+ * swaps the parked buffer out if it is fresh, each with a single atomic exchange, so neither side
+ * ever waits and the state is never copied. States published while the reader is not looking are
+ * simply replaced. Each buffer starts on its own cache line.
+ */
+template <typename T>
+class TripleBuffer {
+    static constexpr std::uint8_t kINDEX_MASK = 0b011;
+    static constexpr std::uint8_t kFRESH = 0b100;
+
+public:
+    using value_type = T;
+
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer: the buffer to fill before the next publish(). It still holds whatever it held when
+    // the writer last got it back, not the latest published state.
+    T& write_buffer() { return buffers_[back_].value_; }
+
+    void publish() {
+        back_ = state_.exchange(back_ | kFRESH, std::memory_order::acq_rel) & kINDEX_MASK;
+    }
+
+    void publish(const T& value) {
+        write_buffer() = value;
+        publish();
+    }
+
+    // Reader: switches to the newest published state if there is one it has not seen yet and
+    // returns true if it did.
+    bool acquire() {
+        if ((state_.load(std::memory_order::relaxed) & kFRESH) == 0) return false;
+        front_ = state_.exchange(front_, std::memory_order::acq_rel) & kINDEX_MASK;
+        return true;
+    }
+
+    // Reader: the state taken by the last successful acquire().
+    const T& read_buffer() const { return buffers_[front_].value_; }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Buffer {
+        T value_{};
+    };
+
+    std::array<Buffer, 3> buffers_;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint8_t> state_{1};
+    alignas(CACHE_LINE_SIZE) std::uint8_t back_ = 2;
+    alignas(CACHE_LINE_SIZE) std::uint8_t front_ = 0;
+    char padding_[CACHE_LINE_SIZE - sizeof(std::uint8_t)];
+};
+
+#endif  // TRIPLEBUFFER_H
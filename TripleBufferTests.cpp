@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "TripleBuffer.h"
+
+class TripleBufferTest : public testing::Test {};
+
+TEST_F(TripleBufferTest, ReaderSeesNewestPublishTest) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.acquire());
+    EXPECT_EQ(buffer.read_buffer(), 0);
+
+    buffer.publish(1);
+    buffer.publish(2);
+    buffer.publish(3);
+    EXPECT_TRUE(buffer.acquire());
+    EXPECT_EQ(buffer.read_buffer(), 3);
+    EXPECT_FALSE(buffer.acquire());
+    EXPECT_EQ(buffer.read_buffer(), 3);
+
+    buffer.write_buffer() = 4;
+    buffer.publish();
+    EXPECT_TRUE(buffer.acquire());
+    EXPECT_EQ(buffer.read_buffer(), 4);
+}
+
+TEST_F(TripleBufferTest, ConcurrentHandoffIsConsistentTest) {
+    using State = std::array<std::uint64_t, 1024>;
+    constexpr std::uint64_t kPUBLISHES = 20'000;
+    auto buffer = std::make_unique<TripleBuffer<State>>();
+    std::atomic<bool> done = false;
+
+    std::thread writer([&] {
+        for (std::uint64_t n = 1; n <= kPUBLISHES; ++n) {
+            buffer->write_buffer().fill(n);
+            buffer->publish();
+        }
+        done = true;
+    });
+
+    std::uint64_t last = 0;
+    int inconsistent = 0;
+    for (;;) {
+        const bool finished = done;
+        if (buffer->acquire()) {
+            const auto& state = buffer->read_buffer();
+            for (const auto word : state)
+                if (word != state[0]) ++inconsistent;
+            if (state[0] <= last) ++inconsistent;
+            last = state[0];
+        } else if (finished) {
+            break;
+        }
+    }
+    writer.join();
+    EXPECT_EQ(inconsistent, 0);
+    EXPECT_EQ(last, kPUBLISHES);
+}
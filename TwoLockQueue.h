@@ -0,0 +1,148 @@
+#ifndef TWOLOCKQUEUE_H
+#define TWOLOCKQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+#include "ConcurrentQueueConcept.h"
+
+/**
+ * @brief Michael-Scott two-lock queue
+ *
+ * Producers only touch the tail under tail_mutex_ and consumers only touch the head under
+ * head_mutex_; the dummy node at the head keeps the two ends apart even when the queue is empty.
+ * The shared element count is the only state both sides read, so a producer only takes the
+ * consumer lock to signal the empty to non-empty transition (and vice versa when bounded).
+ */
+template<typename T>
+class TwoLockQueue {
+public:
+    using value_type = T;
+
+    explicit TwoLockQueue(std::size_t capacity = std::numeric_limits<std::size_t>::max())
+        : capacity_(capacity), head_(new Node), tail_(head_) {}
+
+    TwoLockQueue(const TwoLockQueue&) = delete;
+    TwoLockQueue& operator=(const TwoLockQueue&) = delete;
+
+    ~TwoLockQueue() {
+        while (head_) {
+            Node* next = head_->next_;
+            delete head_;
+            head_ = next;
+        }
+    }
+
+    bool push(const T& item) {
+        auto* node = new Node{item};
+        std::size_t count;
+        {
+            std::unique_lock lock(tail_mutex_);
+            not_full_.wait(lock,
+                           [&] { return count_.load(std::memory_order::acquire) < capacity_; });
+            count = enqueue(node);
+            if (count + 1 < capacity_) not_full_.notify_one();
+        }
+        if (count == 0) signal_not_empty();
+        return true;
+    }
+
+    bool try_push(const T& item) {
+        if (count_.load(std::memory_order::acquire) >= capacity_) return false;
+        auto* node = new Node{item};
+        std::size_t count;
+        {
+            const std::lock_guard lock(tail_mutex_);
+            if (count_.load(std::memory_order::acquire) >= capacity_) {
+                delete node;
+                return false;
+            }
+            count = enqueue(node);
+        }
+        if (count == 0) signal_not_empty();
+        return true;
+    }
+
+    bool pop(T& item) {
+        Node* old_head;
+        std::size_t count;
+        {
+            std::unique_lock lock(head_mutex_);
+            not_empty_.wait(lock, [&] { return count_.load(std::memory_order::acquire) > 0; });
+            old_head = dequeue(item);
+            count = count_.fetch_sub(1, std::memory_order::acq_rel);
+            if (count > 1) not_empty_.notify_one();
+        }
+        delete old_head;
+        if (count == capacity_) signal_not_full();
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        if (count_.load(std::memory_order::acquire) == 0) return false;
+        Node* old_head;
+        std::size_t count;
+        {
+            const std::lock_guard lock(head_mutex_);
+            if (count_.load(std::memory_order::acquire) == 0) return false;
+            old_head = dequeue(item);
+            count = count_.fetch_sub(1, std::memory_order::acq_rel);
+        }
+        delete old_head;
+        if (count == capacity_) signal_not_full();
+        return true;
+    }
+
+private:
+    struct Node {
+        T value_{};
+        Node* next_ = nullptr;
+    };
+
+    // Called with tail_mutex_ held, returns the count before the push.
+    std::size_t enqueue(Node* node) {
+        tail_->next_ = node;
+        tail_ = node;
+        return count_.fetch_add(1, std::memory_order::acq_rel);
+    }
+
+    // Called with head_mutex_ held, returns the old dummy node for deletion outside the lock.
+    Node* dequeue(T& item) {
+        Node* old_head = head_;
+        Node* first = head_->next_;
+        item = std::move(first->value_);
+        head_ = first;
+        return old_head;
+    }
+
+    void signal_not_empty() {
+        const std::lock_guard lock(head_mutex_);
+        not_empty_.notify_one();
+    }
+
+    void signal_not_full() {
+        const std::lock_guard lock(tail_mutex_);
+        not_full_.notify_one();
+    }
+
+    const std::size_t capacity_;
+    alignas(64) std::atomic<std::size_t> count_{0};
+
+    alignas(64) std::mutex head_mutex_;
+    std::condition_variable not_empty_;
+    Node* head_;
+
+    alignas(64) std::mutex tail_mutex_;
+    std::condition_variable not_full_;
+    Node* tail_;
+};
+
+template<typename T>
+struct is_blocking<TwoLockQueue<T>> : std::true_type {};
+
+static_assert(BlockingQueue<TwoLockQueue<int>>,
+              "TwoLockQueue does not satisfy the BlockingQueue concept");
+
+#endif //TWOLOCKQUEUE_H
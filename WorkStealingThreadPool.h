@@ -0,0 +1,150 @@
+#ifndef WORKSTEALINGTHREADPOOL_H
+#define WORKSTEALINGTHREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ConcurrentQueueConcept.h"
+#include "CpuTopology.h"
+#include "Futex.h"
+#include "InplaceTask.h"
+#include "QueueTypeTraits.h"
+#include "ThreadUtils.h"
+
+/**
+ * @brief Thread pool with per-worker queues, a global injection queue and stealing
+ *
+ * Tasks submitted from outside the pool go to the injection queue; tasks submitted by a running
+ * task go to its worker's local queue. A worker takes work from its local queue first, then the
+ * injection queue, then steals from the other workers' local queues starting at a rotating
+ * victim. Idle workers park on a futex that submit() only wakes if somebody is parked.
+ *
+ * Queue is any ConcurrentQueue whose value_type is a task (usually InplaceTask), so swapping
+ * backends is a one-word change. Thieves pop from the same end as the owner, so Queue must allow
+ * several consumers. Bounded queues are built with kLOCAL_CAPACITY slots; a full local queue
+ * overflows into the injection queue.
+ */
+template <ConcurrentQueue Queue>
+    requires std::invocable<typename Queue::value_type&>
+class WorkStealingThreadPool {
+public:
+    using task_type = typename Queue::value_type;
+
+    static constexpr std::size_t kLOCAL_CAPACITY = 4096;
+
+    // With pin_threads set, worker i is pinned to the i-th CPU of the constructing thread's
+    // affinity mask, wrapping around when there are more workers than CPUs. Workers stay unpinned
+    // if the mask can't be read.
+    explicit WorkStealingThreadPool(const unsigned thread_count, const bool pin_threads = false)
+        : global_(make_queue()) {
+        workers_.reserve(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i) workers_.push_back(std::make_unique<Worker>());
+        const std::vector<int> cpus = pin_threads ? allowed_cpus() : std::vector<int>{};
+        for (unsigned i = 0; i < thread_count; ++i) {
+            const int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+            workers_[i]->thread_ = std::thread([this, i, cpu] {
+                pinThread(cpu);
+                run(i);
+            });
+        }
+    }
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    // Runs every task already submitted, then joins the workers.
+    ~WorkStealingThreadPool() {
+        stopping_.store(true, std::memory_order::seq_cst);
+        wake(static_cast<int>(workers_.size()));
+        for (auto& worker : workers_) worker->thread_.join();
+    }
+
+    template <typename F>
+    void submit(F&& f) {
+        task_type task(std::forward<F>(f));
+        if (current_pool_ != this || !workers_[current_worker_]->queue_.try_push(task))
+            global_.push(task);
+        wake(1);
+    }
+
+    [[nodiscard]] std::size_t thread_count() const { return workers_.size(); }
+
+    // Tasks taken from another worker's local queue. Exact once the pool is idle.
+    [[nodiscard]] std::uint64_t steals() const { return steals_.load(std::memory_order::relaxed); }
+
+private:
+    struct Worker {
+        Worker() : queue_(make_queue()) {}
+
+        alignas(64) Queue queue_;
+        std::thread thread_;
+    };
+
+    static Queue make_queue() {
+        if constexpr (is_bounded_v<Queue>)
+            return Queue(kLOCAL_CAPACITY);
+        else
+            return Queue();
+    }
+
+    void run(const std::size_t index) {
+        current_pool_ = this;
+        current_worker_ = index;
+        task_type task;
+        for (;;) {
+            const auto epoch = epoch_.load(std::memory_order::seq_cst);
+            if (find_task(index, task)) {
+                task();
+                task = task_type{};
+                continue;
+            }
+            if (stopping_.load(std::memory_order::seq_cst)) break;
+            sleepers_.fetch_add(1, std::memory_order::seq_cst);
+            futex_wait(epoch_, epoch);
+            sleepers_.fetch_sub(1, std::memory_order::relaxed);
+        }
+        current_pool_ = nullptr;
+    }
+
+    bool find_task(const std::size_t index, task_type& task) {
+        if (workers_[index]->queue_.try_pop(task)) return true;
+        if (global_.try_pop(task)) return true;
+        const std::size_t count = workers_.size();
+        const std::size_t start = next_victim_.fetch_add(1, std::memory_order::relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t victim = (start + i) % count;
+            if (victim != index && workers_[victim]->queue_.try_pop(task)) {
+                steals_.fetch_add(1, std::memory_order::relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The epoch bump orders the preceding push before the sleeper check, and a worker that read
+    // the old epoch before looking for work either sees the push or fails its futex_wait.
+    void wake(const int count) {
+        epoch_.fetch_add(1, std::memory_order::seq_cst);
+        if (sleepers_.load(std::memory_order::seq_cst) != 0) futex_wake(epoch_, count);
+    }
+
+    static inline thread_local WorkStealingThreadPool* current_pool_ = nullptr;
+    static inline thread_local std::size_t current_worker_ = 0;
+
+    Queue global_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    alignas(64) std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<std::uint32_t> sleepers_{0};
+    std::atomic<bool> stopping_{false};
+    alignas(64) std::atomic<std::size_t> next_victim_{0};
+    std::atomic<std::uint64_t> steals_{0};
+};
+
+#endif  // WORKSTEALINGTHREADPOOL_H
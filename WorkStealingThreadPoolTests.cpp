@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "CpuTopology.h"
+#include "InplaceTask.h"
+#include "MichaelScottQueue.h"
+#include "MutexDequeQueue.h"
+#include "MutexRingBufferQueue.h"
+#include "TwoLockQueue.h"
+#include "WorkStealingThreadPool.h"
+
+using PoolQueueTypes = testing::Types<
+    MutexDequeQueue<InplaceTask<>>,
+    MutexRingBufferQueue<InplaceTask<>>,
+    MichaelScottQueue<InplaceTask<>>,
+    TwoLockQueue<InplaceTask<>>
+>;
+
+template <typename T>
+class WorkStealingThreadPoolTypedTest : public testing::Test {};
+
+TYPED_TEST_SUITE(WorkStealingThreadPoolTypedTest, PoolQueueTypes);
+
+TYPED_TEST(WorkStealingThreadPoolTypedTest, RunsExternalTasksTest) {
+    constexpr int kTASKS = 20'000;
+    std::atomic<long long> sum = 0;
+    {
+        WorkStealingThreadPool<TypeParam> pool(4);
+        for (int i = 1; i <= kTASKS; ++i) pool.submit([&sum, i] { sum += i; });
+    }
+    EXPECT_EQ(sum, static_cast<long long>(kTASKS) * (kTASKS + 1) / 2);
+}
+
+TYPED_TEST(WorkStealingThreadPoolTypedTest, RunsNestedTasksTest) {
+    constexpr int kPARENTS = 64;
+    constexpr int kCHILDREN = 256;
+    std::atomic<int> count = 0;
+    {
+        WorkStealingThreadPool<TypeParam> pool(4);
+        for (int p = 0; p < kPARENTS; ++p) {
+            pool.submit([&pool, &count] {
+                for (int c = 0; c < kCHILDREN; ++c) pool.submit([&count] { ++count; });
+            });
+        }
+    }
+    EXPECT_EQ(count, kPARENTS * kCHILDREN);
+}
+
+TEST(WorkStealingThreadPoolTest, PinnedWorkersStayInAffinityMaskTest) {
+    constexpr int kTASKS = 2'000;
+    const std::vector<int> allowed = allowed_cpus();
+    ASSERT_FALSE(allowed.empty());
+    std::atomic<int> outside = 0;
+    std::atomic<int> ran = 0;
+    {
+        // More workers than CPUs, so the assignment has to wrap around the mask.
+        WorkStealingThreadPool<MutexDequeQueue<InplaceTask<>>> pool(
+            static_cast<unsigned>(allowed.size()) + 2, true);
+        for (int i = 0; i < kTASKS; ++i) {
+            pool.submit([&] {
+                if (!std::ranges::binary_search(allowed, ::sched_getcpu())) ++outside;
+                ++ran;
+            });
+        }
+    }
+    EXPECT_EQ(ran, kTASKS);
+    EXPECT_EQ(outside, 0);
+}
+
+TEST(InplaceTaskTest, CopiesAndDestroysCallableTest) {
+    auto counter = std::make_shared<int>(0);
+    {
+        InplaceTask<> task([counter] { ++*counter; });
+        InplaceTask<> copy = task;
+        EXPECT_EQ(counter.use_count(), 3);
+
+        InplaceTask<> moved = std::move(task);
+        task = InplaceTask<>{};
+        EXPECT_FALSE(task);
+        copy();
+        moved();
+        EXPECT_EQ(*counter, 2);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
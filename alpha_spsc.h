@@ -3,11 +3,19 @@
 
 #include <emmintrin.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
-constexpr std::size_t CACHE_LINE_SIZE = 64;
+#include "CacheLine.h"
+#include "ConcurrentQueueConcept.h"
+#include "OverflowPolicy.h"
+#include "QueueTypeTraits.h"
+#include "SimdCopy.h"
 
 
 namespace alpha {
@@ -16,8 +24,17 @@ namespace alpha {
 //                 SPSC with all optimisations
 //=================================================================================
 
-template <typename T, unsigned SIZE, T NIL>
+// Slots always hold a live T, so items are assigned in and moved out; a ring of shared_ptr does
+// not keep popped items alive. NIL is unused and may be any value, so T need not be structural.
+// POLICY picks what push() does when the ring is full. DropOldest lets the producer advance head
+// itself, so the consumer claims items with a CAS on head and may copy a slot the producer is
+// overwriting; it discards that copy when the CAS fails, which needs T to be trivially copyable.
+template <typename T, unsigned SIZE, auto NIL = nullptr,
+          OverflowPolicy POLICY = OverflowPolicy::Block>
 class spsc {
+    static_assert(POLICY != OverflowPolicy::DropOldest || std::is_trivially_copyable_v<T>,
+                  "DropOldest reads slots that may be concurrently overwritten");
+
 public:
     using value_type = T;
     using size_type = std::size_t;
@@ -27,8 +44,30 @@ public:
     spsc& operator=(spsc&) = delete;
 
     // push
-    void push(const T& item) {
-        while (!try_push(item)) _mm_pause();
+    bool push(const T& item) {
+        if constexpr (POLICY == OverflowPolicy::Block) {
+            while (!try_push(item)) _mm_pause();
+        } else if constexpr (POLICY == OverflowPolicy::DropNewest) {
+            if (!try_push(item)) {
+                dropped_.store(dropped_.load(std::memory_order::relaxed) + 1,
+                               std::memory_order::relaxed);
+                return false;
+            }
+        } else {
+            auto tail = tail_.load(std::memory_order::relaxed);
+            auto head = head_.load(std::memory_order::acquire);
+            while (full(tail, head)) {
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order::acq_rel,
+                                                std::memory_order::acquire)) {
+                    dropped_.store(dropped_.load(std::memory_order::relaxed) + 1,
+                                   std::memory_order::relaxed);
+                    break;
+                }
+            }
+            data_[tail % SIZE] = item;
+            tail_.store(tail + 1, std::memory_order::release);
+        }
+        return true;
     }
 
     bool try_push(const T& item) {
@@ -37,33 +76,87 @@ public:
             cached_head_ = head_.load(std::memory_order::acquire);
             if (full(tail, cached_head_)) return false;
         }
-        new (&data_[tail % SIZE]) T(item);
+        data_[tail % SIZE] = item;
         tail_.store(tail + 1, std::memory_order::release);
         return true;
     }
 
     // pop
-    void pop(T& item) {
+    bool pop(T& item) {
         while (!try_pop(item)) _mm_pause();
+        return true;
     }
 
     bool try_pop(T& item) {
+        if constexpr (POLICY == OverflowPolicy::DropOldest) {
+            auto head = head_.load(std::memory_order::acquire);
+            for (;;) {
+                if (empty(tail_.load(std::memory_order::acquire), head)) return false;
+                item = data_[head % SIZE];
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order::acq_rel,
+                                                std::memory_order::acquire))
+                    return true;
+            }
+        }
         auto head = head_.load(std::memory_order::relaxed);
         if (empty(cached_tail_, head)) {
             cached_tail_ = tail_.load(std::memory_order::acquire);
             if (empty(cached_tail_, head)) return false;
         }
-        item = data_[head % SIZE];
+        item = std::move(data_[head % SIZE]);
         head_.store(head + 1, std::memory_order::release);
         return true;
     }
 
+    // Copies up to count items in with at most two vectorised copies and a single publish.
+    // Returns how many fit. Not available under DropOldest, where the producer can move head.
+    size_type try_push_bulk(const T* items, size_type count,
+                            const simd::StoreHint hint = simd::StoreHint::Cached)
+        requires(POLICY != OverflowPolicy::DropOldest)
+    {
+        const auto tail = tail_.load(std::memory_order::relaxed);
+        if (SIZE - (tail - cached_head_) < count)
+            cached_head_ = head_.load(std::memory_order::acquire);
+        count = std::min<size_type>(count, SIZE - (tail - cached_head_));
+        const auto offset = tail % SIZE;
+        const auto first = std::min<size_type>(count, SIZE - offset);
+        simd::copy_items(data_ + offset, items, first, hint);
+        simd::copy_items(data_, items + first, count - first, hint);
+        tail_.store(tail + count, std::memory_order::release);
+        return count;
+    }
+
+    size_type try_pop_bulk(T* out, size_type max)
+        requires(POLICY != OverflowPolicy::DropOldest)
+    {
+        const auto head = head_.load(std::memory_order::relaxed);
+        if (cached_tail_ - head < max) cached_tail_ = tail_.load(std::memory_order::acquire);
+        max = std::min<size_type>(max, cached_tail_ - head);
+        const auto offset = head % SIZE;
+        const auto first = std::min<size_type>(max, SIZE - offset);
+        simd::move_items(out, data_ + offset, first);
+        simd::move_items(out + first, data_, max - first);
+        head_.store(head + max, std::memory_order::release);
+        return max;
+    }
+
     [[nodiscard]] unsigned capacity() const noexcept { return SIZE; }
 
     [[nodiscard]] bool empty() const noexcept {
         return head_.load(std::memory_order::relaxed) == tail_.load(std::memory_order::relaxed);
     }
 
+    // Items discarded by push() under a drop policy.
+    [[nodiscard]] std::uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order::relaxed);
+    }
+
+    // Snapshot of the number of items; head is read first so it never exceeds tail.
+    [[nodiscard]] size_type size() const noexcept {
+        const auto head = head_.load(std::memory_order::relaxed);
+        return tail_.load(std::memory_order::relaxed) - head;
+    }
+
 private:
     [[nodiscard]] static bool full(const size_type tail, const size_type head) {
         return tail - head >= SIZE;
@@ -76,6 +169,7 @@ private:
     T data_[SIZE];
     alignas(CACHE_LINE_SIZE) std::atomic<size_type> head_{0};
     alignas(CACHE_LINE_SIZE) size_type cached_head_ = 0;
+    std::atomic<std::uint64_t> dropped_{0};
     alignas(CACHE_LINE_SIZE) std::atomic<size_type> tail_{0};
     alignas(CACHE_LINE_SIZE) size_type cached_tail_ = 0;
     char padding_[CACHE_LINE_SIZE - sizeof(size_type)];
@@ -88,7 +182,7 @@ namespace bravo {
 //                 No alignas / with false sharing
 //=================================================================================
 
-template <typename T, unsigned SIZE, T NIL>
+template <typename T, unsigned SIZE, auto NIL = nullptr>
 class spsc {
 public:
     using value_type = T;
@@ -99,8 +193,9 @@ public:
     spsc& operator=(spsc&) = delete;
 
     // push
-    void push(const T& item) {
+    bool push(const T& item) {
         while (!try_push(item)) _mm_pause();
+        return true;
     }
 
     bool try_push(const T& item) {
@@ -115,8 +210,9 @@ public:
     }
 
     // pop
-    void pop(T& item) {
+    bool pop(T& item) {
         while (!try_pop(item)) _mm_pause();
+        return true;
     }
 
     bool try_pop(T& item) {
@@ -159,7 +255,7 @@ namespace charlie {
 //                 Sequentially consistent memory order
 //=================================================================================
 
-template <typename T, unsigned SIZE, T NIL>
+template <typename T, unsigned SIZE, auto NIL = nullptr>
 class spsc {
 public:
     using value_type = T;
@@ -170,8 +266,9 @@ public:
     spsc& operator=(spsc&) = delete;
 
     // push
-    void push(const T& item) {
+    bool push(const T& item) {
         while (!try_push(item)) _mm_pause();
+        return true;
     }
 
     bool try_push(const T& item) {
@@ -186,8 +283,9 @@ public:
     }
 
     // pop
-    void pop(T& item) {
+    bool pop(T& item) {
         while (!try_pop(item)) _mm_pause();
+        return true;
     }
 
     bool try_pop(T& item) {
@@ -231,7 +329,7 @@ namespace delta {
 //                 No cached head/tail indexes
 //=================================================================================
 
-template <typename T, unsigned SIZE, T NIL>
+template <typename T, unsigned SIZE, auto NIL = nullptr>
 class spsc {
 public:
     using value_type = T;
@@ -242,8 +340,9 @@ public:
     spsc& operator=(spsc&) = delete;
 
     // push
-    void push(const T& item) {
+    bool push(const T& item) {
         while (!try_push(item)) _mm_pause();
+        return true;
     }
 
     bool try_push(const T& item) {
@@ -257,8 +356,9 @@ public:
     }
 
     // pop
-    void pop(T& item) {
+    bool pop(T& item) {
         while (!try_pop(item)) _mm_pause();
+        return true;
     }
 
     bool try_pop(T& item) {
@@ -299,7 +399,7 @@ namespace echo {
 //                 Buffer array on heap instead of stack
 //=================================================================================
 
-template <typename T, unsigned SIZE, T NIL>
+template <typename T, unsigned SIZE, auto NIL = nullptr>
 class spsc {
 public:
     using value_type = T;
@@ -310,8 +410,9 @@ public:
     spsc& operator=(spsc&) = delete;
 
     // push
-    void push(const T& item) {
+    bool push(const T& item) {
         while (!try_push(item)) _mm_pause();
+        return true;
     }
 
     bool try_push(const T& item) {
@@ -326,8 +427,9 @@ public:
     }
 
     // pop
-    void pop(T& item) {
+    bool pop(T& item) {
         while (!try_pop(item)) _mm_pause();
+        return true;
     }
 
     bool try_pop(T& item) {
@@ -365,4 +467,39 @@ private:
 };
 }  // namespace echo
 
+template <typename T, unsigned SIZE, auto NIL, OverflowPolicy POLICY>
+struct max_producers<alpha::spsc<T, SIZE, NIL, POLICY>> : std::integral_constant<unsigned, 1> {};
+template <typename T, unsigned SIZE, auto NIL, OverflowPolicy POLICY>
+struct max_consumers<alpha::spsc<T, SIZE, NIL, POLICY>> : std::integral_constant<unsigned, 1> {};
+template <typename T, unsigned SIZE, auto NIL, OverflowPolicy POLICY>
+struct is_lossy<alpha::spsc<T, SIZE, NIL, POLICY>>
+    : std::bool_constant<POLICY != OverflowPolicy::Block> {};
+
+template <typename T, unsigned SIZE, auto NIL>
+struct max_producers<bravo::spsc<T, SIZE, NIL>> : std::integral_constant<unsigned, 1> {};
+template <typename T, unsigned SIZE, auto NIL>
+struct max_consumers<bravo::spsc<T, SIZE, NIL>> : std::integral_constant<unsigned, 1> {};
+
+template <typename T, unsigned SIZE, auto NIL>
+struct max_producers<charlie::spsc<T, SIZE, NIL>> : std::integral_constant<unsigned, 1> {};
+template <typename T, unsigned SIZE, auto NIL>
+struct max_consumers<charlie::spsc<T, SIZE, NIL>> : std::integral_constant<unsigned, 1> {};
+
+template <typename T, unsigned SIZE, auto NIL>
+struct max_producers<delta::spsc<T, SIZE, NIL>> : std::integral_constant<unsigned, 1> {};
+template <typename T, unsigned SIZE, auto NIL>
+struct max_consumers<delta::spsc<T, SIZE, NIL>> : std::integral_constant<unsigned, 1> {};
+
+template <typename T, unsigned SIZE, auto NIL>
+struct max_producers<echo::spsc<T, SIZE, NIL>> : std::integral_constant<unsigned, 1> {};
+template <typename T, unsigned SIZE, auto NIL>
+struct max_consumers<echo::spsc<T, SIZE, NIL>> : std::integral_constant<unsigned, 1> {};
+
+static_assert(SpscQueue<alpha::spsc<int, 4>> && BatchQueue<alpha::spsc<int, 4>>,
+              "alpha::spsc does not satisfy the SpscQueue and BatchQueue concepts");
+static_assert(SpscQueue<bravo::spsc<int, 4>>, "bravo::spsc does not satisfy SpscQueue");
+static_assert(SpscQueue<charlie::spsc<int, 4>>, "charlie::spsc does not satisfy SpscQueue");
+static_assert(SpscQueue<delta::spsc<int, 4>>, "delta::spsc does not satisfy SpscQueue");
+static_assert(SpscQueue<echo::spsc<int, 4>>, "echo::spsc does not satisfy SpscQueue");
+
 #endif  // ALPHA_SPSC_H
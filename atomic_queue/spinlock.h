@@ -91,7 +91,7 @@ public:
     }
 
     void unlock() noexcept {
-        unlock(next_.load(std::memory_order_relaxed) + 1);
+        unlock(next_.load(std::memory_order_relaxed));
     }
 
     void unlock(unsigned ticket) noexcept {
@@ -107,6 +107,7 @@ class UnfairSpinlock {
 public:
     using scoped_lock = std::lock_guard<UnfairSpinlock>;
 
+    UnfairSpinlock() noexcept = default;
     UnfairSpinlock(UnfairSpinlock const&) = delete;
     UnfairSpinlock& operator=(UnfairSpinlock const&) = delete;
 
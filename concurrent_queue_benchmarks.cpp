@@ -1,29 +1,75 @@
 
 #include <gtest/internal/gtest-internal.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <climits>
+#include <cmath>
+#include <coroutine>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <latch>
+#include <memory>
 #include <limits>
 #include <locale>
 #include <numeric>
+#include <optional>
 #include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include "AtomicQueueAdapters.h"
+#include "AwaitableQueue.h"
 #include "Barrier.h"
+#include "BenchmarkResults.h"
+#include "BenchmarkStats.h"
 #include "BoostLockFreeAdapters.h"
+#include "CacheLine.h"
+#include "ConflatingQueue.h"
+#include "CoroutineExecutors.h"
+#include "CpuTopology.h"
+#include "InplaceMessageQueue.h"
+#include "InplaceTask.h"
+#include "LatencyHistogram.h"
+#include "EventFdNotifier.h"
+#include "LockPolicy.h"
+#include "MichaelScottQueue.h"
 #include "MoodeyCamelQueueAdapters.h"
 #include "MutexBoostRingBufferQueue.h"
 #include "MutexDequeQueue.h"
 #include "MutexListQueue.h"
 #include "MutexRingBufferQueue.h"
+#include "NodePool.h"
+#include "NotifyPolicy.h"
+#include "OverflowPolicy.h"
+#include "Pipeline.h"
+#include "QueueSelector.h"
+#include "SeqlockSlot.h"
+#include "SimdCopy.h"
 #include "StdAtomicMPMCQueue.h"
 #include "StdAtomicSPSCQueue.h"
+#include "ThreadUtils.h"
+#include "TripleBuffer.h"
+#include "TwoLockQueue.h"
+#include "WorkStealingThreadPool.h"
 #include "alpha_spsc.h"
 #include "RigtorpQueueAdapters.h"
 #include "atomic_queue/atomic_queue.h"
+#include "atomic_queue/spinlock.h"
 #include "CppConAdapters.h"
 
 constexpr unsigned kQUEUE_SIZE = 16'384;
@@ -44,6 +90,7 @@ enum class BenchmarkType {
     Balanced,
     SingleProducer,
     SingleConsumer,
+    SingleBulkConsumer,
 };
 
 std::string format_number(const long num) {
@@ -60,22 +107,53 @@ std::string format_number(const long double num) {
     return ss.str();
 }
 
-static void pinThread(int cpu) {
-    if (cpu < 0) {
-        return;
+ReclamationStats reclamation_totals;
+NotifyStats notify_totals;
+
+template <typename Queue>
+void accumulate_queue_stats(const Queue& queue) {
+    if constexpr (requires { queue.reclamation_stats(); }) {
+        reclamation_totals += queue.reclamation_stats();
     }
-    ::cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-    CPU_SET(cpu, &cpuset);
-    if (::pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == -1) {
-        std::perror("pthread_setaffinity_rp");
-        std::exit(EXIT_FAILURE);
+    if constexpr (requires { queue.notify_stats(); }) {
+        notify_totals += queue.notify_stats();
     }
 }
 
+void reset_queue_stats() {
+    reclamation_totals = {};
+    notify_totals = {};
+}
+
+// scan_ns is summed over every thread, so it is compared with the thread time of the runs (wall
+// time times the number of threads) rather than the wall time alone, which could exceed 100%.
+void print_queue_stats(const nano_t total_duration, const unsigned thread_count) {
+    if (reclamation_totals.retired != 0) {
+        const double thread_time = static_cast<double>(total_duration) * thread_count;
+        std::println(
+            "   reclamation: {:>10} retired - {:>8} scans - {:>6.1f} ns/retired node"
+            " - {:>5.2f}% of thread time in scans",
+            reclamation_totals.retired, reclamation_totals.scans,
+            static_cast<double>(reclamation_totals.scan_ns) / reclamation_totals.retired,
+            100.0 * static_cast<double>(reclamation_totals.scan_ns) / thread_time);
+    }
+    // notify_one() calls are an upper bound on FUTEX_WAKE syscalls: glibc already skips the
+    // syscall when it can see there are no waiters, but still pays for the condvar bookkeeping.
+    if (const auto total = notify_totals.notifications + notify_totals.skipped; total != 0) {
+        std::println("   notify_one: {:>12} calls - {:>12} skipped - {:>6.2f}% avoided",
+                     notify_totals.notifications, notify_totals.skipped,
+                     100.0 * static_cast<double>(notify_totals.skipped) / total);
+    }
+}
+
+// CPUs for the producer and consumer of 1P/1C throughput runs. The placement sweep sets it;
+// every other run leaves both threads unpinned.
+CpuPair spsc_placement;
+
 template <typename Queue>
-void producer(Queue& queue, unsigned num_items, Barrier& barrier, std::atomic<nano_t>& start) {
-    //pinThread(1);
+void producer(Queue& queue, unsigned num_items, Barrier& barrier, std::atomic<nano_t>& start,
+              const int cpu) {
+    pinThread(cpu);
 
     barrier.wait();
     const unsigned stop_flag = num_items + 1;
@@ -114,8 +192,8 @@ void single_producer(Queue& queue, const unsigned num_items, Barrier& barrier,
 
 template <typename Queue>
 void consumer(Queue& queue, unsigned stop_flag, Barrier& barrier,
-              std::atomic<unsigned>& active_consumers, nano_t& end, uint64_t& sum) {
-    //pinThread(11);
+              std::atomic<unsigned>& active_consumers, nano_t& end, uint64_t& sum, const int cpu) {
+    pinThread(cpu);
 
     barrier.wait();
 
@@ -153,6 +231,46 @@ void single_consumer(Queue& queue, unsigned stop_flag, Barrier& barrier, nano_t&
     sum = local_sum;
 }
 
+template <typename Queue>
+concept PopAllQueue = requires(Queue q, std::vector<unsigned> v) { q.pop_all(v); };
+
+template <typename Queue>
+concept BulkPopQueue = PopAllQueue<Queue> || BatchQueue<Queue>;
+
+// Drains the queue a batch at a time: with pop_all() where the queue has it, taking the lock once
+// per batch instead of once per item, and with try_pop_bulk() otherwise.
+template <typename Queue>
+void single_bulk_consumer(Queue& queue, unsigned stop_flag, Barrier& barrier, nano_t& end,
+                          unsigned producer_count, uint64_t& sum) {
+    constexpr std::size_t kBATCH = 256;
+    barrier.wait();
+
+    uint64_t local_sum = 0;
+    std::vector<unsigned> batch;
+    if constexpr (!PopAllQueue<Queue>) batch.resize(kBATCH);
+    while (producer_count != 0) {
+        std::size_t count;
+        if constexpr (PopAllQueue<Queue>) {
+            batch.clear();
+            queue.pop_all(batch);
+            count = batch.size();
+        } else {
+            count = queue.try_pop_bulk(batch.data(), kBATCH);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            if (batch[i] == stop_flag)
+                --producer_count;
+            else
+                local_sum += batch[i];
+        }
+    }
+
+    const auto now = high_resolution_clock::now();
+    end = duration_cast<nanoseconds>(now.time_since_epoch()).count();
+
+    sum = local_sum;
+}
+
 template <typename Queue>
 nano_t balanced_benchmark_iteration(const unsigned thread_count,
                                     const uint64_t items_per_producer) {
@@ -164,19 +282,21 @@ nano_t balanced_benchmark_iteration(const unsigned thread_count,
     nano_t end = 0;
     std::atomic<unsigned> active_consumers{thread_count};
     auto queue = createQueue<Queue>();
+    const CpuPair cpus = thread_count == 1 ? spsc_placement : CpuPair{};
     for (unsigned i = 0; i < thread_count; ++i) {
         threads[i] = std::thread(producer<Queue>, std::ref(queue), items_per_producer,
-                                 std::ref(barrier), std::ref(start));
+                                 std::ref(barrier), std::ref(start), cpus.first);
     }
 
     for (unsigned i = 0; i < thread_count; ++i) {
         threads[thread_count + i] =
             std::thread(consumer<Queue>, std::ref(queue), items_per_producer + 1, std::ref(barrier),
-                        std::ref(active_consumers), std::ref(end), std::ref(sums[i]));
+                        std::ref(active_consumers), std::ref(end), std::ref(sums[i]), cpus.second);
     }
 
     barrier.release(thread_count * 2);
     for (auto& t : threads) t.join();
+    accumulate_queue_stats(queue);
 
     // check total sum
     const uint64_t expected_sum =
@@ -209,16 +329,17 @@ nano_t single_producer_benchmark_iteration(const unsigned consumer_count,
     for (unsigned i = 0; i < consumer_count; ++i) {
         threads[1 + i] =
             std::thread(consumer<Queue>, std::ref(queue), items_per_producer + 1, std::ref(barrier),
-                        std::ref(active_consumers), std::ref(end), std::ref(sums[i]));
+                        std::ref(active_consumers), std::ref(end), std::ref(sums[i]), -1);
     }
 
     barrier.release(consumer_count + 1);
     for (auto& t : threads) t.join();
+    accumulate_queue_stats(queue);
 
     return end - start;
 }
 
-template <typename Queue>
+template <typename Queue, bool BULK = false>
 nano_t single_consumer_benchmark_iteration(const unsigned producer_count,
                                            const unsigned items_per_producer) {
     Barrier barrier;
@@ -231,132 +352,1419 @@ nano_t single_consumer_benchmark_iteration(const unsigned producer_count,
 
     for (unsigned i = 0; i < producer_count; ++i) {
         threads[i] = std::thread(producer<Queue>, std::ref(queue), items_per_producer,
-                                 std::ref(barrier), std::ref(start));
+                                 std::ref(barrier), std::ref(start), -1);
     }
 
-    threads[producer_count] =
-        std::thread(single_consumer<Queue>, std::ref(queue), items_per_producer + 1,
-                    std::ref(barrier), std::ref(end), producer_count, std::ref(total_sum));
+    if constexpr (BULK) {
+        threads[producer_count] =
+            std::thread(single_bulk_consumer<Queue>, std::ref(queue), items_per_producer + 1,
+                        std::ref(barrier), std::ref(end), producer_count, std::ref(total_sum));
+    } else {
+        threads[producer_count] =
+            std::thread(single_consumer<Queue>, std::ref(queue), items_per_producer + 1,
+                        std::ref(barrier), std::ref(end), producer_count, std::ref(total_sum));
+    }
 
     barrier.release(producer_count + 1);
     for (auto& t : threads) t.join();
+    accumulate_queue_stats(queue);
     return end - start.load(std::memory_order::relaxed);
 }
 
+// BT is a template parameter so a topology the queue cannot run is rejected at compile time rather
+// than measured as a zero-length run.
+template <typename Queue, BenchmarkType BT>
+nano_t benchmark_iteration(const unsigned thread_count) {
+    if constexpr (BT == BenchmarkType::Balanced) {
+        return balanced_benchmark_iteration<Queue>(thread_count, kNUM_ITEMS / thread_count);
+    } else if constexpr (BT == BenchmarkType::SingleProducer) {
+        return single_producer_benchmark_iteration<Queue>(thread_count, kNUM_ITEMS);
+    } else if constexpr (BT == BenchmarkType::SingleConsumer) {
+        return single_consumer_benchmark_iteration<Queue>(thread_count, kNUM_ITEMS / thread_count);
+    } else {
+        static_assert(BT == BenchmarkType::SingleBulkConsumer);
+        static_assert(BulkPopQueue<Queue>,
+                      "the single-bulk-consumer benchmark needs a queue satisfying BulkPopQueue");
+        return single_consumer_benchmark_iteration<Queue, true>(thread_count,
+                                                                kNUM_ITEMS / thread_count);
+    }
+}
+
+// Warm-up, repetition and confidence settings shared by every run_benchmark_set().
+RunnerConfig runner_config;
+
+// Every measured set, written out by --json/--csv and checked against --baseline.
+BenchmarkResults results;
+
+char const* benchmark_type_name(const BenchmarkType bt) {
+    switch (bt) {
+        case BenchmarkType::Balanced: return "balanced";
+        case BenchmarkType::SingleProducer: return "single-producer";
+        case BenchmarkType::SingleConsumer: return "single-consumer";
+        case BenchmarkType::SingleBulkConsumer: return "single-bulk-consumer";
+    }
+    return "?";
+}
+
+// The fields of a result that describe Queue and the topology it ran in.
 template <typename Queue>
-void run_benchmark_set(char const* benchmark_name, BenchmarkType bt, unsigned min_threads,
-                       unsigned max_threads) {
-    constexpr unsigned RUNS = 11;
+BenchmarkRecord record_for(char const* benchmark, char const* queue_name, const unsigned producers,
+                           const unsigned consumers) {
+    return {.benchmark = benchmark,
+            .queue = queue_name,
+            .producers = producers,
+            .consumers = consumers,
+            .payload_bytes = sizeof(typename Queue::value_type),
+            .capacity = is_bounded_v<Queue> ? kQUEUE_SIZE : 0};
+}
+
+template <typename Queue>
+void record_result(char const* benchmark, char const* queue_name, const unsigned producers,
+                   const unsigned consumers, const SampleSummary& summary) {
+    auto record = record_for<Queue>(benchmark, queue_name, producers, consumers);
+    record.summary = summary;
+    results.add(std::move(record));
+}
+
+// Repeats each thread count until the median throughput is pinned down (see RunnerConfig) and
+// reports it with its confidence interval and spread, so two queues can be told apart by more
+// than noise.
+template <typename Queue, BenchmarkType BT>
+void run_benchmark_set(char const* benchmark_name, unsigned min_threads, unsigned max_threads) {
     std::cout << benchmark_name << '\n';
 
     for (unsigned thread_count = min_threads; thread_count <= max_threads; ++thread_count) {
-        nano_t min_duration = std::numeric_limits<nano_t>::max();
-        nano_t max_duration = std::numeric_limits<nano_t>::min();
+        const unsigned producers = BT == BenchmarkType::SingleProducer ? 1 : thread_count;
+        const unsigned consumers =
+            BT == BenchmarkType::SingleConsumer || BT == BenchmarkType::SingleBulkConsumer
+                ? 1
+                : thread_count;
         nano_t total_duration = 0;
-
-        for (unsigned i = 0; i < RUNS; ++i) {
-            switch (bt) {
-                case BenchmarkType::Balanced: {
-                    const uint64_t items_per_producer = kNUM_ITEMS / thread_count;
-                    auto duration =
-                        balanced_benchmark_iteration<Queue>(thread_count, items_per_producer);
-                    min_duration = std::min(min_duration, duration);
-                    max_duration = std::max(max_duration, duration);
-                    total_duration += duration;
-                    break;
-                }
-                case BenchmarkType::SingleProducer: {
-                    auto duration =
-                        single_producer_benchmark_iteration<Queue>(thread_count, kNUM_ITEMS);
-                    min_duration = std::min(min_duration, duration);
-                    max_duration = std::max(max_duration, duration);
-                    total_duration += duration;
-                    break;
-                }
-                case BenchmarkType::SingleConsumer: {
-                    const uint64_t items_per_producer = kNUM_ITEMS / thread_count;
-                    auto duration = single_consumer_benchmark_iteration<Queue>(thread_count,
-                                                                               items_per_producer);
-                    min_duration = std::min(min_duration, duration);
-                    max_duration = std::max(max_duration, duration);
-                    total_duration += duration;
-                    break;
-                }
-                default: {
-                    assert(false);
-                    break;
-                }
-            }
-        }  // 1 - RUNS loop
+        const auto summary = stats::run_until_stable(
+            runner_config,
+            [&] {
+                const nano_t duration = benchmark_iteration<Queue, BT>(thread_count);
+                total_duration += duration;
+                return static_cast<double>(kNUM_ITEMS) / (static_cast<double>(duration) / 1e9);
+            },
+            [&] {
+                total_duration = 0;
+                reset_queue_stats();
+            });
 
         std::println(
             "-> {:>2} Producer {:>2} Consumer"
-            " - avg: {:>12} msg/s - min: {:>12} msg/s - max: {:>12} msg/s",
-            bt == BenchmarkType::SingleProducer ? 1 : thread_count,
-            bt == BenchmarkType::SingleConsumer ? 1 : thread_count,
-            format_number(
-                static_cast<long>(kNUM_ITEMS / (static_cast<double>(total_duration) / RUNS / 1e9))),
-            format_number(
-                static_cast<long>(kNUM_ITEMS / (static_cast<double>(max_duration) / 1e9))),
-            format_number(
-                static_cast<long>(kNUM_ITEMS / (static_cast<double>(min_duration) / 1e9))));
+            " - median: {:>12} msg/s - {:.0f}% CI: [{:>12}, {:>12}]"
+            " - min: {:>12} msg/s - max: {:>12} msg/s",
+            producers, consumers, format_number(static_cast<long>(summary.median)),
+            runner_config.confidence * 100, format_number(static_cast<long>(summary.ci_low)),
+            format_number(static_cast<long>(summary.ci_high)),
+            format_number(static_cast<long>(summary.min)),
+            format_number(static_cast<long>(summary.max)));
+        const std::string outliers =
+            summary.outliers.empty()
+                ? std::string()
+                : " - " + std::to_string(summary.outliers.size()) + " outlier run(s)";
+        std::println("   {} runs after {} warm-up - MAD: {:.2f}% - stddev: {:.2f}%"
+                     " - CI: +/-{:.2f}%{}",
+                     summary.count, runner_config.warmup_runs,
+                     100.0 * summary.mad / summary.median, 100.0 * summary.stddev / summary.median,
+                     100.0 * summary.ci_half_width(), outliers);
+        print_queue_stats(total_duration, producers + consumers);
+        record_result<Queue>(benchmark_type_name(BT), benchmark_name, producers, consumers,
+                             summary);
     }  // min_threads - max_threads loop
 }
 
 template <typename Queue>
 void mpmc_benchmark(char const* benchmark_name, const unsigned min_threads,
                     const unsigned max_threads) {
-    run_benchmark_set<Queue>(benchmark_name, BenchmarkType::Balanced, min_threads, max_threads);
+    run_benchmark_set<Queue, BenchmarkType::Balanced>(benchmark_name, min_threads, max_threads);
 }
 
 template <typename Queue>
 void spsc_benchmark(char const* benchmark_name) {
-    run_benchmark_set<Queue>(benchmark_name, BenchmarkType::Balanced, 1, 1);
+    run_benchmark_set<Queue, BenchmarkType::Balanced>(benchmark_name, 1, 1);
 }
 
 template <typename Queue>
 void spmc_benchmark(char const* benchmark_name, unsigned int max_consumer_count) {
-    run_benchmark_set<Queue>(benchmark_name, BenchmarkType::SingleProducer, 2, max_consumer_count);
+    run_benchmark_set<Queue, BenchmarkType::SingleProducer>(benchmark_name, 2, max_consumer_count);
 }
 
 template <typename Queue>
 void mpsc_benchmark(char const* benchmark_name, unsigned int max_producer_count) {
-    run_benchmark_set<Queue>(benchmark_name, BenchmarkType::SingleConsumer, 2, max_producer_count);
+    run_benchmark_set<Queue, BenchmarkType::SingleConsumer>(benchmark_name, 2, max_producer_count);
 }
 
-void spsc_benchmark_suite() {
-    std::println("----------- SPSC Benchmarks -----------");
+// Time spent holding the lock of the queue under test, summed over every acquisition.
+struct LockHoldTotals {
+    nano_t held_ns = 0;
+    std::uint64_t holds = 0;
+};
+LockHoldTotals lock_hold_totals;
+
+// A std::mutex that adds how long it was held to lock_hold_totals. The totals are only written
+// while the lock is held, so they need no synchronisation of their own as long as one queue is
+// measured at a time. Each hold includes one steady_clock read.
+class HoldTimingMutex {
+public:
+    void lock() {
+        mutex_.lock();
+        acquired_ = steady_clock::now();
+    }
+
+    bool try_lock() {
+        if (!mutex_.try_lock()) return false;
+        acquired_ = steady_clock::now();
+        return true;
+    }
+
+    void unlock() {
+        lock_hold_totals.held_ns +=
+            duration_cast<nanoseconds>(steady_clock::now() - acquired_).count();
+        ++lock_hold_totals.holds;
+        mutex_.unlock();
+    }
+
+private:
+    std::mutex mutex_;
+    steady_clock::time_point acquired_;
+};
+
+// Moves kLOCK_HOLD_ITEMS items through the queue and reports the mean time its lock was held per
+// acquisition, which is where the default allocator and the NodePool differ: both allocate and
+// free nodes inside the critical section. With pairs == 0 one thread alternates batches of pushes
+// and pops, so the lock is never contended; otherwise `pairs` producers feed as many consumers.
+constexpr unsigned kLOCK_HOLD_ITEMS = 4'000'000;
+
+template <typename Queue>
+void lock_hold_benchmark(char const* benchmark_name, const unsigned pairs) {
+    constexpr unsigned RUNS = 5;
+    nano_t min_duration = std::numeric_limits<nano_t>::max();
+    double min_hold = std::numeric_limits<double>::max();
+
+    for (unsigned run = 0; run < RUNS; ++run) {
+        auto queue = createQueue<Queue>();
+        lock_hold_totals = {};
+        const auto start = high_resolution_clock::now();
+        if (pairs == 0) {
+            constexpr unsigned kBATCH = 1024;
+            for (unsigned b = 0; b < kLOCK_HOLD_ITEMS / kBATCH; ++b) {
+                for (unsigned n = 0; n < kBATCH; ++n) queue.push(n);
+                unsigned item;
+                for (unsigned n = 0; n < kBATCH; ++n) queue.pop(item);
+            }
+        } else {
+            const unsigned per_thread = kLOCK_HOLD_ITEMS / pairs;
+            std::vector<std::thread> threads;
+            for (unsigned t = 0; t < pairs; ++t) {
+                threads.emplace_back([&] {
+                    for (unsigned n = 0; n < per_thread; ++n) queue.push(n);
+                });
+                threads.emplace_back([&] {
+                    unsigned item;
+                    for (unsigned n = 0; n < per_thread; ++n) queue.pop(item);
+                });
+            }
+            for (auto& t : threads) t.join();
+        }
+        min_duration = std::min(
+            min_duration,
+            duration_cast<nanoseconds>(high_resolution_clock::now() - start).count());
+        min_hold = std::min(min_hold, static_cast<double>(lock_hold_totals.held_ns) /
+                                          static_cast<double>(lock_hold_totals.holds));
+    }
+
+    const std::string topology = pairs == 0 ? std::string("uncontended")
+                                            : std::to_string(pairs) + "P/" +
+                                                  std::to_string(pairs) + "C";
+    std::println("{:<40} - {:<11} - lock held: {:>6.1f} ns/acquisition - {:>6.1f} ns/item",
+                 benchmark_name, topology, min_hold,
+                 static_cast<double>(min_duration) / kLOCK_HOLD_ITEMS);
+}
+
+template <typename Queue>
+void lock_hold_benchmark_set(char const* benchmark_name) {
+    lock_hold_benchmark<Queue>(benchmark_name, 0);
+    lock_hold_benchmark<Queue>(benchmark_name, 2);
+}
+
+void lock_hold_benchmark_suite() {
+    std::println("----------- Lock hold time: default allocator vs NodePool -----------");
+
+    lock_hold_benchmark_set<MutexDequeQueue<unsigned, HoldTimingMutex>>("MutexDequeQueue");
+    lock_hold_benchmark_set<PooledQueue<pmr::MutexDequeQueue<unsigned, HoldTimingMutex>>>(
+        "pmr::MutexDequeQueue + NodePool");
+    lock_hold_benchmark_set<MutexListQueue<unsigned, HoldTimingMutex>>("MutexListQueue");
+    lock_hold_benchmark_set<PooledQueue<pmr::MutexListQueue<unsigned, HoldTimingMutex>>>(
+        "pmr::MutexListQueue + NodePool");
+
+    std::println();
+}
 
-    // spsc_benchmark<MutexDequeQueue<unsigned>>("MutexDequeQueue");
-    // spsc_benchmark<MutexListQueue<unsigned>>("MutexListQueue");
+constexpr unsigned kPING_PONG_ROUNDS = 200'000;
+
+void print_round_trip(char const* benchmark_name, const nano_t total_duration,
+                      const nano_t min_duration, const unsigned runs) {
+    std::println("{:<40} - avg: {:>8.1f} ns/round trip - min: {:>8.1f} ns/round trip",
+                 benchmark_name,
+                 static_cast<double>(total_duration) / runs / kPING_PONG_ROUNDS,
+                 static_cast<double>(min_duration) / kPING_PONG_ROUNDS);
+}
 
-    // spsc_benchmark<MutexRingBufferQueue<unsigned>>("MutexRingBufferQueue");
-    // spsc_benchmark<MutexBoostRingBufferQueue<unsigned>>("MutexBoostRingBufferQueue");
-    //spsc_benchmark<StdAtomicSPSCQueue<unsigned, 16384>>("StdAtomicSPSCQueue");
-    //spsc_benchmark<StdAtomicMPMCQueue<unsigned, 16384>>("StdAtomicMPMCQueue");
+// Two threads bouncing one item back and forth, each blocking in pop() until the other replies.
+template <typename Queue>
+void thread_ping_pong_benchmark(char const* benchmark_name) {
+    constexpr unsigned RUNS = 11;
+    nano_t min_duration = std::numeric_limits<nano_t>::max();
+    nano_t total_duration = 0;
+
+    for (unsigned i = 0; i < RUNS; ++i) {
+        auto ping = createQueue<Queue>();
+        auto pong = createQueue<Queue>();
+        const auto start = high_resolution_clock::now();
+        std::thread echo([&] {
+            unsigned item;
+            for (unsigned n = 0; n < kPING_PONG_ROUNDS; ++n) {
+                ping.pop(item);
+                pong.push(item);
+            }
+        });
+        unsigned item;
+        for (unsigned n = 0; n < kPING_PONG_ROUNDS; ++n) {
+            ping.push(n);
+            pong.pop(item);
+        }
+        echo.join();
+        const auto duration =
+            duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+        min_duration = std::min(min_duration, duration);
+        total_duration += duration;
+    }
+    print_round_trip(benchmark_name, total_duration, min_duration, RUNS);
+}
 
-    spsc_benchmark<alpha::spsc<unsigned, 16384, UINT_MAX>>("alpha::spsc - all optimisations");
-    spsc_benchmark<bravo::spsc<unsigned, 16384, UINT_MAX>>("beta::spsc - with false sharing");
-    spsc_benchmark<charlie::spsc<unsigned, 16384, UINT_MAX>>("charlie::spsc - seq_cst mem order");
-    spsc_benchmark<delta::spsc<unsigned, 16384, UINT_MAX>>("delta::spsc - no cached head/tail");
-    spsc_benchmark<echo::spsc<unsigned, 16384, UINT_MAX>>("echo::spsc - array on heap not stack");
-    spsc_benchmark<alpha::spsc<unsigned, 16385, UINT_MAX>>("alpha::spsc - SIZE not power of 2");
+Task ping_pong_echo(AwaitableQueue<unsigned>& ping, AwaitableQueue<unsigned>& pong,
+                    std::latch& done) {
+    for (unsigned n = 0; n < kPING_PONG_ROUNDS; ++n) co_await pong.push(co_await ping.pop());
+    done.count_down();
+}
 
-    spsc_benchmark<BoostLockFreeSPSCQueue<unsigned, 16384>>("BoostLockFreeSPSCQueue");
-    spsc_benchmark<RigtorpSPSCAdapter<unsigned>>("rigtorp::SPSCQueue");
+Task ping_pong_origin(AwaitableQueue<unsigned>& ping, AwaitableQueue<unsigned>& pong,
+                      std::latch& done) {
+    for (unsigned n = 0; n < kPING_PONG_ROUNDS; ++n) {
+        co_await ping.push(n);
+        co_await pong.pop();
+    }
+    done.count_down();
+}
 
-    // spsc_benchmark<MoodyCamelBlockingQueue<unsigned>>("MoodyCamelBlockingQueue");
-    // spsc_benchmark<MoodyCamelLockFreeQueue<unsigned>>("MoodyCamelLockFreeQueue");
+// The same exchange between two coroutines, which suspend instead of blocking a thread. drive
+// runs or waits on the executor until both coroutines have counted down the latch.
+template <typename Drive>
+void coroutine_ping_pong_benchmark(char const* benchmark_name, Executor& executor, Drive drive) {
+    constexpr unsigned RUNS = 11;
+    nano_t min_duration = std::numeric_limits<nano_t>::max();
+    nano_t total_duration = 0;
+
+    for (unsigned i = 0; i < RUNS; ++i) {
+        AwaitableQueue<unsigned> ping(1);
+        AwaitableQueue<unsigned> pong(1);
+        std::latch done(2);
+        const auto start = high_resolution_clock::now();
+        spawn(executor, ping_pong_echo(ping, pong, done));
+        spawn(executor, ping_pong_origin(ping, pong, done));
+        drive(done);
+        const auto duration =
+            duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+        min_duration = std::min(min_duration, duration);
+        total_duration += duration;
+    }
+    print_round_trip(benchmark_name, total_duration, min_duration, RUNS);
+}
 
-    spsc_benchmark<AtomicQueueSPSCAdapter<unsigned, 16384>>("AtomicQueue(SPSC=true)");
-    //std::println("sizeof atomic<unsigned>: {}", sizeof(std::atomic<unsigned>));
-    //std::println("sizeof queue: {}", sizeof(atomic_queue::AtomicQueue<unsigned, 16384>));
-    spsc_benchmark<OptimistAtomicQueueSPSCAdapter<unsigned, 16384>>(
-        "OptimistAtomicQueue(SPSC=true)");
+void coroutine_ping_pong_benchmark_suite() {
+    std::println("----------- Ping-pong: coroutines vs threads -----------");
 
-    //spsc_benchmark<fifo2_adapter<unsigned, 16384>>("cppcon fifo2 (atomics)");
-    //spsc_benchmark<fifo3_adapter<unsigned, 16384>>("cppcon fifo3 (memory orders, false sharing)");
-    spsc_benchmark<fifo4_adapter<unsigned, 16384>>("cppcon fifo4 (cached head/tail)");
+    SingleThreadExecutor single_thread;
+    coroutine_ping_pong_benchmark("AwaitableQueue, SingleThreadExecutor", single_thread,
+                                  [&](std::latch&) { single_thread.run_until_idle(); });
+    {
+        ThreadPoolExecutor pool(2);
+        coroutine_ping_pong_benchmark("AwaitableQueue, ThreadPoolExecutor(2)", pool,
+                                      [](std::latch& done) { done.wait(); });
+    }
+    thread_ping_pong_benchmark<MutexRingBufferQueue<unsigned>>("MutexRingBufferQueue, 2 threads");
+    thread_ping_pong_benchmark<MutexDequeQueue<unsigned>>("MutexDequeQueue, 2 threads");
+
+    std::println();
+}
+
+constexpr unsigned kWAKEUP_MESSAGES = 20'000;
+
+nano_t now_ns() {
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void print_latency(char const* benchmark_name, std::vector<nano_t>& latencies) {
+    std::ranges::sort(latencies);
+    const auto total = std::accumulate(latencies.begin(), latencies.end(), nano_t{0});
+    const double avg = static_cast<double>(total) / static_cast<double>(latencies.size());
+    std::println("{:<40} - avg: {:>8.0f} ns - p50: {:>8} ns - p99: {:>8} ns", benchmark_name, avg,
+                 latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100]);
+}
+
+// Sends timestamps spaced far enough apart that the consumer has gone back to sleep before each.
+template <typename Queue>
+void send_spaced_timestamps(Queue& queue) {
+    for (unsigned n = 0; n < kWAKEUP_MESSAGES; ++n) {
+        queue.push(now_ns());
+        std::this_thread::sleep_for(microseconds(20));
+    }
+}
+
+// Stops the run with the call's errno message when a benchmark's socket or epoll setup fails.
+void check_setup(const int rc, char const* call) {
+    if (rc < 0) {
+        std::perror(call);
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+// One epoll thread services a socket carrying unrelated background traffic and the queue's
+// eventfd, and measures how long each message took from push() to being popped.
+template <typename Queue>
+void epoll_wakeup_benchmark(char const* benchmark_name) {
+    auto queue = createQueue<NotifyingQueue<Queue>>();
+    int sockets[2];
+    check_setup(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sockets), "socketpair");
+    const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    check_setup(epoll_fd, "epoll_create1");
+    for (const int fd : {sockets[0], queue.fd()}) {
+        epoll_event event{.events = EPOLLIN, .data = {.fd = fd}};
+        check_setup(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event), "epoll_ctl");
+    }
+
+    std::vector<nano_t> latencies;
+    latencies.reserve(kWAKEUP_MESSAGES);
+    std::atomic<bool> done = false;
+
+    std::thread background([&] {
+        const char byte = 0;
+        while (!done.load(std::memory_order::relaxed)) {
+            [[maybe_unused]] const auto written = write(sockets[1], &byte, 1);
+            std::this_thread::sleep_for(microseconds(100));
+        }
+    });
+
+    std::thread io_thread([&] {
+        epoll_event events[2];
+        char buffer[256];
+        while (latencies.size() < kWAKEUP_MESSAGES) {
+            const int ready = epoll_wait(epoll_fd, events, 2, -1);
+            for (int i = 0; i < ready; ++i) {
+                if (events[i].data.fd == queue.fd()) {
+                    queue.acknowledge();
+                    nano_t sent;
+                    while (queue.try_pop(sent)) latencies.push_back(now_ns() - sent);
+                } else {
+                    while (read(events[i].data.fd, buffer, sizeof(buffer)) > 0) {}
+                }
+            }
+        }
+    });
+
+    send_spaced_timestamps(queue);
+    io_thread.join();
+    done = true;
+    background.join();
+    close(epoll_fd);
+    close(sockets[0]);
+    close(sockets[1]);
+
+    print_latency(benchmark_name, latencies);
+}
+
+// The same measurement with a dedicated consumer thread blocked in pop().
+template <typename Queue>
+void blocking_wakeup_benchmark(char const* benchmark_name) {
+    auto queue = createQueue<Queue>();
+    std::vector<nano_t> latencies;
+    latencies.reserve(kWAKEUP_MESSAGES);
+
+    std::thread consumer([&] {
+        nano_t sent;
+        for (unsigned n = 0; n < kWAKEUP_MESSAGES; ++n) {
+            queue.pop(sent);
+            latencies.push_back(now_ns() - sent);
+        }
+    });
+
+    send_spaced_timestamps(queue);
+    consumer.join();
+
+    print_latency(benchmark_name, latencies);
+}
+
+void wakeup_latency_benchmark_suite() {
+    std::println("----------- Wakeup latency: epoll + eventfd vs blocking pop -----------");
+
+    epoll_wakeup_benchmark<MutexDequeQueue<nano_t>>("epoll, NotifyingQueue<MutexDequeQueue>");
+    epoll_wakeup_benchmark<MoodyCamelLockFreeQueue<nano_t>>(
+        "epoll, NotifyingQueue<MoodyCamelQueue>");
+    blocking_wakeup_benchmark<MutexDequeQueue<nano_t>>("condition variable, MutexDequeQueue");
+    blocking_wakeup_benchmark<MoodyCamelBlockingQueue<nano_t>>(
+        "semaphore, MoodyCamelBlockingQueue");
+
+    std::println();
+}
+
+constexpr unsigned kFAN_IN_ITEMS = 2'000;
+using FanInInbox = alpha::spsc<nano_t, 1024, 0>;
+
+nano_t thread_cpu_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1'000'000'000LL + ts.tv_nsec;
+}
+
+// Each producer sends a timestamp to its own inbox every 50us, so most inboxes are empty most of
+// the time.
+template <typename Inbox>
+std::vector<std::thread> start_sparse_producers(std::vector<std::unique_ptr<Inbox>>& inboxes) {
+    std::vector<std::thread> producers;
+    producers.reserve(inboxes.size());
+    for (auto& inbox : inboxes) {
+        producers.emplace_back([&inbox] {
+            for (unsigned n = 0; n < kFAN_IN_ITEMS; ++n) {
+                inbox->push(now_ns());
+                std::this_thread::sleep_for(microseconds(50));
+            }
+        });
+    }
+    return producers;
+}
+
+// Drives the consumer on this thread until every item has arrived. drain_ready(on_item) must
+// pop whatever is available, call on_item(timestamp) per item and return the number popped.
+template <typename Inbox, typename DrainReady>
+void fan_in_benchmark(char const* benchmark_name, const unsigned producer_count,
+                      DrainReady drain_ready, std::vector<std::unique_ptr<Inbox>>& inboxes) {
+    const std::size_t total = std::size_t{producer_count} * kFAN_IN_ITEMS;
+    std::size_t received = 0;
+    nano_t latency = 0;
+    auto on_item = [&](const nano_t sent) {
+        latency += now_ns() - sent;
+        ++received;
+    };
+
+    auto producers = start_sparse_producers(inboxes);
+    const auto cpu_start = thread_cpu_ns();
+    const auto start = now_ns();
+    while (received < total) drain_ready(on_item);
+    const auto wall = now_ns() - start;
+    const auto cpu = thread_cpu_ns() - cpu_start;
+    for (auto& t : producers) t.join();
+
+    std::println("{:<32} - {:>2} producers - consumer cpu: {:>5.1f}% of wall - "
+                 "avg latency: {:>8.0f} ns",
+                 benchmark_name, producer_count,
+                 100.0 * static_cast<double>(cpu) / static_cast<double>(wall),
+                 static_cast<double>(latency) / static_cast<double>(total));
+}
+
+void fan_in_select_benchmark(const unsigned producer_count) {
+    using Inbox = SelectableQueue<FanInInbox>;
+    QueueSelector<> selector;
+    std::vector<std::unique_ptr<Inbox>> inboxes;
+    for (unsigned i = 0; i < producer_count; ++i)
+        inboxes.push_back(std::make_unique<Inbox>(selector, i));
+
+    fan_in_benchmark("QueueSelector", producer_count, [&](auto& on_item) {
+        selector.select([&](const std::size_t i) {
+            nano_t sent;
+            while (inboxes[i]->try_pop(sent)) on_item(sent);
+        });
+    }, inboxes);
+}
+
+void fan_in_round_robin_benchmark(const unsigned producer_count) {
+    std::vector<std::unique_ptr<FanInInbox>> inboxes;
+    for (unsigned i = 0; i < producer_count; ++i)
+        inboxes.push_back(std::make_unique<FanInInbox>());
+
+    fan_in_benchmark("Round-robin polling", producer_count, [&](auto& on_item) {
+        bool found = false;
+        for (auto& inbox : inboxes) {
+            nano_t sent;
+            while (inbox->try_pop(sent)) {
+                on_item(sent);
+                found = true;
+            }
+        }
+        if (!found) _mm_pause();
+    }, inboxes);
+}
+
+void fan_in_benchmark_suite() {
+    std::println("----------- Fan-in: QueueSelector vs round-robin polling -----------");
+
+    for (const unsigned producers : {8u, 16u, 32u, 64u}) {
+        fan_in_select_benchmark(producers);
+        fan_in_round_robin_benchmark(producers);
+    }
+
+    std::println();
+}
+
+constexpr unsigned kPOOL_TASKS = 1'000'000;
+constexpr unsigned kPOOL_LATENCY_TASKS = 10'000;
+
+// Per-worker tally of the tasks a worker ran and their summed submit-to-run latency. Each worker
+// writes only its own slot, so counting adds no cache line that all workers fight over.
+struct alignas(CACHE_LINE_SIZE) PoolTaskSlot {
+    std::atomic<unsigned> completed = 0;
+    nano_t latency = 0;
+};
+
+// The calling worker's slot. Every run builds a new pool, so each worker thread starts with none.
+thread_local PoolTaskSlot* pool_task_slot = nullptr;
+
+// Submits kPOOL_TASKS tasks either from this thread (through the injection queue) or from a
+// single root task (through one worker's local queue, so the other workers have to steal), and
+// reports task throughput and the average submit-to-run latency of the fastest run.
+template <typename Queue>
+void thread_pool_throughput(char const* benchmark_name, const unsigned threads,
+                            const bool from_worker, const bool pin_threads) {
+    constexpr unsigned RUNS = 5;
+    nano_t min_duration = std::numeric_limits<nano_t>::max();
+    nano_t latency = 0;
+    std::uint64_t steals = 0;
+
+    for (unsigned i = 0; i < RUNS; ++i) {
+        std::vector<PoolTaskSlot> slots(threads);
+        std::atomic<unsigned> next_slot = 0;
+        WorkStealingThreadPool<Queue> pool(threads, pin_threads);
+        auto submit_all = [&pool, &slots, &next_slot] {
+            for (unsigned n = 0; n < kPOOL_TASKS; ++n) {
+                pool.submit([&slots, &next_slot, sent = now_ns()] {
+                    if (pool_task_slot == nullptr) pool_task_slot = &slots[next_slot++];
+                    pool_task_slot->latency += now_ns() - sent;
+                    pool_task_slot->completed.store(
+                        pool_task_slot->completed.load(std::memory_order::relaxed) + 1,
+                        std::memory_order::release);
+                });
+            }
+        };
+        const auto completed = [&slots] {
+            unsigned total = 0;
+            for (const auto& slot : slots) total += slot.completed.load(std::memory_order::acquire);
+            return total;
+        };
+
+        const auto start = now_ns();
+        if (from_worker)
+            pool.submit(submit_all);
+        else
+            submit_all();
+        while (completed() != kPOOL_TASKS) std::this_thread::yield();
+        if (const auto duration = now_ns() - start; duration < min_duration) {
+            min_duration = duration;
+            latency = 0;
+            for (const auto& slot : slots) latency += slot.latency;
+            steals = pool.steals();
+        }
+    }
+
+    std::println("{:<32} - {:<8} - {:>6.2f} Mtasks/s - avg submit-to-run: {:>10.0f} ns - "
+                 "{:>8} steals",
+                 benchmark_name, from_worker ? "internal" : "external",
+                 kPOOL_TASKS * 1e3 / static_cast<double>(min_duration),
+                 static_cast<double>(latency) / kPOOL_TASKS, steals);
+}
+
+// One task in flight at a time, so every submit has to wake a parked worker.
+template <typename Queue>
+void thread_pool_idle_latency(char const* benchmark_name, const unsigned threads,
+                              const bool pin_threads) {
+    WorkStealingThreadPool<Queue> pool(threads, pin_threads);
+    std::vector<nano_t> latencies;
+    latencies.reserve(kPOOL_LATENCY_TASKS);
+    std::atomic<nano_t> ran_at = 0;
+
+    for (unsigned n = 0; n < kPOOL_LATENCY_TASKS; ++n) {
+        ran_at.store(0, std::memory_order::relaxed);
+        const auto sent = now_ns();
+        pool.submit([&ran_at] { ran_at.store(now_ns(), std::memory_order::release); });
+        nano_t ran;
+        while ((ran = ran_at.load(std::memory_order::acquire)) == 0) std::this_thread::yield();
+        latencies.push_back(ran - sent);
+        std::this_thread::sleep_for(microseconds(20));
+    }
+    print_latency(benchmark_name, latencies);
+}
+
+template <typename Queue>
+void thread_pool_benchmark(char const* benchmark_name, const unsigned threads,
+                           const bool pin_threads = false) {
+    thread_pool_throughput<Queue>(benchmark_name, threads, false, pin_threads);
+    thread_pool_throughput<Queue>(benchmark_name, threads, true, pin_threads);
+    thread_pool_idle_latency<Queue>(benchmark_name, threads, pin_threads);
+}
+
+void thread_pool_benchmark_suite() {
+    std::println("----------- Work-stealing thread pool (4 workers) -----------");
+
+    using Task = InplaceTask<>;
+    thread_pool_benchmark<MutexDequeQueue<Task>>("MutexDequeQueue", 4);
+    thread_pool_benchmark<MutexDequeQueue<Task>>("MutexDequeQueue (pinned)", 4, true);
+    thread_pool_benchmark<MutexDequeQueue<Task, AdaptiveMutex>>("MutexDequeQueue<AdaptiveMutex>",
+                                                                4);
+    thread_pool_benchmark<MutexRingBufferQueue<Task>>("MutexRingBufferQueue", 4);
+    thread_pool_benchmark<TwoLockQueue<Task>>("TwoLockQueue", 4);
+    thread_pool_benchmark<MichaelScottQueue<Task>>("MichaelScottQueue", 4);
+    thread_pool_benchmark<MoodyCamelBlockingQueue<Task>>("MoodyCamelBlockingQueue", 4);
+
+    std::println();
+}
+
+constexpr unsigned kPIPELINE_MESSAGES = 2'000'000;
+
+struct IngestMessage {
+    nano_t sent = 0;
+    std::uint64_t id = 0;
+    std::uint64_t fields[4] = {};
+};
+
+// Core for stage i when pinning: 0 is left to the producer and consumer threads.
+int stage_cpu(const unsigned stage) {
+    return stage + 1 < std::thread::hardware_concurrency() ? static_cast<int>(stage + 1) : -1;
+}
+
+void pipeline_benchmark_suite() {
+    std::println("----------- 4-stage pipeline over alpha::spsc -----------");
+
+    auto p = pipeline::Builder<IngestMessage>{}
+                 .stage("parse", [](IngestMessage m) {
+                     for (std::size_t i = 0; i < 4; ++i)
+                         m.fields[i] = (m.id + i) * 0x9E3779B97F4A7C15ULL;
+                     return m;
+                 }, stage_cpu(0))
+                 .stage("enrich", [](IngestMessage m) {
+                     m.fields[1] ^= m.fields[0] >> 17;
+                     m.fields[2] += m.fields[3] >> 5;
+                     return m;
+                 }, stage_cpu(1))
+                 .stage("route", [](IngestMessage m) {
+                     m.fields[3] = m.fields[0] % 8;
+                     return m;
+                 }, stage_cpu(2))
+                 .stage("serialize", [](const IngestMessage& m) {
+                     const auto payload = static_cast<nano_t>(m.fields[1] ^ m.fields[2]);
+                     return std::array<nano_t, 2>{m.sent, payload};
+                 }, stage_cpu(3))
+                 .build();
+    p->start();
+
+    std::vector<nano_t> latencies;
+    latencies.reserve(kPIPELINE_MESSAGES);
+    std::thread sink([&] {
+        std::array<nano_t, 2> out;
+        while (p->pop(out)) latencies.push_back(now_ns() - out[0]);
+    });
+
+    const auto start = now_ns();
+    for (std::uint64_t n = 0; n < kPIPELINE_MESSAGES; ++n)
+        p->push(IngestMessage{.sent = now_ns(), .id = n});
+    p->close();
+    sink.join();
+    const auto duration = now_ns() - start;
+    p->join();
+
+    std::println("end-to-end: {:.2f} M messages/s",
+                 kPIPELINE_MESSAGES * 1e3 / static_cast<double>(duration));
+    print_latency("per-message latency", latencies);
+    for (const auto& stage : p->stats()) {
+        std::println("   {:<10} - input stall: {:>8.2f} ms - output stall: {:>8.2f} ms - "
+                     "avg input occupancy: {:>7.1f}",
+                     stage.name, duration_cast<microseconds>(stage.input_stall).count() / 1e3,
+                     duration_cast<microseconds>(stage.output_stall).count() / 1e3,
+                     stage.average_occupancy());
+    }
+    std::println("   {:<10} - backpressure: {:>7.2f} ms", "producer",
+                 duration_cast<microseconds>(p->source_stall()).count() / 1e3);
+
+    std::println();
+}
+
+constexpr unsigned kOVERLOAD_ITEMS = 1'000'000;
+
+// The consumer spends ~200ns per item, far slower than the producer can push, so the queue stays
+// full and the overflow policy decides what every push costs.
+template <typename Queue>
+void overload_benchmark(char const* benchmark_name) {
+    auto queue = createQueue<Queue>();
+    std::atomic<bool> done = false;
+    std::thread consumer([&] {
+        unsigned item;
+        for (;;) {
+            const bool finished = done.load(std::memory_order::acquire);
+            if (!queue.try_pop(item)) {
+                if (finished) return;
+                continue;
+            }
+            const auto until = now_ns() + 200;
+            while (now_ns() < until) {}
+        }
+    });
+
+    std::vector<nano_t> latencies;
+    latencies.reserve(kOVERLOAD_ITEMS);
+    for (unsigned n = 0; n < kOVERLOAD_ITEMS; ++n) {
+        const auto start = now_ns();
+        queue.push(n);
+        latencies.push_back(now_ns() - start);
+    }
+    done = true;
+    consumer.join();
+
+    print_latency(benchmark_name, latencies);
+    std::println("   dropped: {:>5.1f}%",
+                 100.0 * static_cast<double>(queue.dropped()) / kOVERLOAD_ITEMS);
+}
+
+void overload_benchmark_suite() {
+    std::println("----------- Producer push latency under overload -----------");
+
+    using enum OverflowPolicy;
+    overload_benchmark<MutexRingBufferQueue<unsigned, std::mutex, NotifyWaiters, Block>>(
+        "MutexRingBufferQueue - Block");
+    overload_benchmark<MutexRingBufferQueue<unsigned, std::mutex, NotifyWaiters, DropNewest>>(
+        "MutexRingBufferQueue - DropNewest");
+    overload_benchmark<MutexRingBufferQueue<unsigned, std::mutex, NotifyWaiters, DropOldest>>(
+        "MutexRingBufferQueue - DropOldest");
+    overload_benchmark<alpha::spsc<unsigned, 16384, UINT_MAX, Block>>("alpha::spsc - Block");
+    overload_benchmark<alpha::spsc<unsigned, 16384, UINT_MAX, DropNewest>>(
+        "alpha::spsc - DropNewest");
+    overload_benchmark<alpha::spsc<unsigned, 16384, UINT_MAX, DropOldest>>(
+        "alpha::spsc - DropOldest");
+    overload_benchmark<StdAtomicMPMCQueue<unsigned, 16384, Block>>("StdAtomicMPMCQueue - Block");
+    overload_benchmark<StdAtomicMPMCQueue<unsigned, 16384, DropNewest>>(
+        "StdAtomicMPMCQueue - DropNewest");
+    overload_benchmark<StdAtomicMPMCQueue<unsigned, 16384, DropOldest>>(
+        "StdAtomicMPMCQueue - DropOldest");
+
+    std::println();
+}
+
+constexpr unsigned kBROADCAST_UPDATES = 1'000'000;
+
+struct TopOfBook {
+    std::uint64_t sequence = 0;
+    double bid = 0;
+    double ask = 0;
+    std::uint64_t bid_qty = 0;
+    std::uint64_t ask_qty = 0;
+    nano_t stamped = 0;
+};
+
+TopOfBook make_top_of_book(const std::uint64_t n) {
+    return {n, 100.0 + n % 7, 100.5 + n % 7, n % 1000, n % 900, 0};
+}
+
+// Reader counts are summed across readers: reads are completed loads or pops, updates_seen the
+// distinct updates among them. Writer latencies are per update.
+void print_broadcast(char const* benchmark_name, const unsigned readers, const nano_t duration,
+                     const std::uint64_t reads, const std::uint64_t updates_seen,
+                     std::vector<nano_t>& writer_latencies) {
+    std::ranges::sort(writer_latencies);
+    std::println("{:<24} - {:>2} readers - {:>7.2f} M reads/s per reader - {:>5.1f}% of updates "
+                 "seen - writer p50: {:>6} ns - p99: {:>6} ns",
+                 benchmark_name, readers,
+                 static_cast<double>(reads) * 1e3 / static_cast<double>(duration) / readers,
+                 100.0 * static_cast<double>(updates_seen) / (double{kBROADCAST_UPDATES} * readers),
+                 writer_latencies[writer_latencies.size() / 2],
+                 writer_latencies[writer_latencies.size() * 99 / 100]);
+}
+
+void seqlock_broadcast_benchmark(const unsigned readers) {
+    SeqlockSlot<TopOfBook> slot;
+    std::latch started(readers);
+    std::atomic<bool> go = false;
+    std::atomic<bool> done = false;
+    std::atomic<std::uint64_t> reads = 0;
+    std::atomic<std::uint64_t> updates_seen = 0;
+
+    std::vector<std::thread> threads;
+    for (unsigned r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            TopOfBook top;
+            std::uint64_t local_reads = 0;
+            std::uint64_t seen = 0;
+            std::uint64_t last_version = 0;
+            started.count_down();
+            while (!go.load(std::memory_order::acquire)) _mm_pause();
+            // Every load() counts as a read, whether or not the writer has moved on since the
+            // last one; seen counts the distinct versions among them.
+            while (!done.load(std::memory_order::relaxed)) {
+                const auto version = slot.load(top);
+                ++local_reads;
+                if (version != last_version) {
+                    last_version = version;
+                    ++seen;
+                }
+            }
+            reads += local_reads;
+            updates_seen += seen;
+        });
+    }
+
+    std::vector<nano_t> latencies;
+    latencies.reserve(kBROADCAST_UPDATES);
+    started.wait();
+    const auto start = now_ns();
+    go.store(true, std::memory_order::release);
+    for (std::uint64_t n = 1; n <= kBROADCAST_UPDATES; ++n) {
+        const auto top = make_top_of_book(n);
+        const auto before = now_ns();
+        slot.store(top);
+        latencies.push_back(now_ns() - before);
+    }
+    done = true;
+    for (auto& t : threads) t.join();
+
+    print_broadcast("SeqlockSlot", readers, now_ns() - start, reads, updates_seen, latencies);
+}
+
+// The writer pushes every update into one alpha::spsc per reader and waits whenever the slowest
+// reader's ring is full.
+void queue_broadcast_benchmark(const unsigned readers) {
+    using Ring = alpha::spsc<TopOfBook, 1024>;
+    std::vector<std::unique_ptr<Ring>> rings;
+    for (unsigned r = 0; r < readers; ++r) rings.push_back(std::make_unique<Ring>());
+    std::latch started(readers);
+    std::atomic<bool> done = false;
+    std::atomic<std::uint64_t> reads = 0;
+
+    std::vector<std::thread> threads;
+    for (unsigned r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            TopOfBook top;
+            std::uint64_t local_reads = 0;
+            started.count_down();
+            for (;;) {
+                const bool finished = done.load(std::memory_order::acquire);
+                if (rings[r]->try_pop(top))
+                    ++local_reads;
+                else if (finished)
+                    break;
+            }
+            reads += local_reads;
+        });
+    }
+
+    std::vector<nano_t> latencies;
+    latencies.reserve(kBROADCAST_UPDATES);
+    started.wait();
+    const auto start = now_ns();
+    for (std::uint64_t n = 1; n <= kBROADCAST_UPDATES; ++n) {
+        const auto top = make_top_of_book(n);
+        const auto before = now_ns();
+        for (auto& ring : rings) ring->push(top);
+        latencies.push_back(now_ns() - before);
+    }
+    done = true;
+    for (auto& t : threads) t.join();
+
+    print_broadcast("alpha::spsc per reader", readers, now_ns() - start, reads, reads, latencies);
+}
+
+void broadcast_benchmark_suite() {
+    std::println("----------- Latest-value broadcast: SeqlockSlot vs queues -----------");
+
+    for (const unsigned readers : {1u, 2u, 4u, 8u, 16u}) {
+        seqlock_broadcast_benchmark(readers);
+        queue_broadcast_benchmark(readers);
+    }
+
+    std::println();
+}
+
+constexpr unsigned kHANDOFF_PUBLISHES = 100'000;
+
+// A large snapshot (32 KB) the writer rebuilds in full every publish.
+struct HandoffState {
+    std::uint64_t version = 0;
+    nano_t stamped = 0;
+    std::array<std::uint64_t, 4094> words{};
+};
+
+void fill_handoff_state(HandoffState& state, const std::uint64_t version) {
+    state.version = version;
+    std::ranges::fill(state.words, version);
+    state.stamped = now_ns();
+}
+
+struct HandoffReader {
+    std::uint64_t fresh = 0;
+    std::uint64_t last_version = 0;
+    nano_t age_sum = 0;
+    std::uint64_t checksum = 0;
+
+    void consume(const HandoffState& state) {
+        ++fresh;
+        last_version = state.version;
+        age_sum += now_ns() - state.stamped;
+        checksum += state.words.front() + state.words.back();
+    }
+};
+
+void print_handoff(char const* benchmark_name, const nano_t publish_duration,
+                   const HandoffReader& reader) {
+    std::println("{:<40} - publish: {:>6} ns - fresh states seen: {:>6.2f}% - average age: {:>8} "
+                 "ns", benchmark_name, publish_duration / kHANDOFF_PUBLISHES,
+                 100.0 * static_cast<double>(reader.fresh) / kHANDOFF_PUBLISHES,
+                 reader.fresh ? reader.age_sum / reader.fresh : 0);
+}
+
+void triple_buffer_handoff_benchmark() {
+    auto buffer = std::make_unique<TripleBuffer<HandoffState>>();
+    std::atomic<bool> done = false;
+    HandoffReader reader;
+
+    std::thread consumer([&] {
+        for (;;) {
+            const bool finished = done.load(std::memory_order::acquire);
+            if (buffer->acquire())
+                reader.consume(buffer->read_buffer());
+            else if (finished)
+                break;
+        }
+    });
+
+    const auto start = now_ns();
+    for (std::uint64_t n = 1; n <= kHANDOFF_PUBLISHES; ++n) {
+        fill_handoff_state(buffer->write_buffer(), n);
+        buffer->publish();
+    }
+    const auto publish_duration = now_ns() - start;
+    done.store(true, std::memory_order::release);
+    consumer.join();
+
+    print_handoff("TripleBuffer (in place)", publish_duration, reader);
+}
+
+// Every publish allocates a fresh shared_ptr snapshot; the reader drains the queue and keeps only
+// the newest one. A full bounded queue drops the publish instead of waiting.
+template <typename Queue>
+void shared_ptr_handoff_benchmark(char const* benchmark_name, Queue& queue) {
+    using Snapshot = std::shared_ptr<const HandoffState>;
+    std::atomic<bool> done = false;
+    HandoffReader reader;
+
+    std::thread consumer([&] {
+        Snapshot snapshot;
+        for (;;) {
+            const bool finished = done.load(std::memory_order::acquire);
+            Snapshot newest;
+            while (queue.try_pop(snapshot)) newest = std::move(snapshot);
+            if (newest)
+                reader.consume(*newest);
+            else if (finished)
+                break;
+        }
+    });
+
+    const auto start = now_ns();
+    for (std::uint64_t n = 1; n <= kHANDOFF_PUBLISHES; ++n) {
+        auto state = std::make_shared<HandoffState>();
+        fill_handoff_state(*state, n);
+        queue.try_push(Snapshot(std::move(state)));
+    }
+    const auto publish_duration = now_ns() - start;
+    done.store(true, std::memory_order::release);
+    consumer.join();
+
+    print_handoff(benchmark_name, publish_duration, reader);
+}
+
+void state_handoff_benchmark_suite() {
+    std::println("----------- Latest-state handoff: TripleBuffer vs shared_ptr -----------");
+
+    triple_buffer_handoff_benchmark();
+    {
+        auto ring = std::make_unique<alpha::spsc<std::shared_ptr<const HandoffState>, 64>>();
+        shared_ptr_handoff_benchmark("alpha::spsc<shared_ptr> (drop when full)", *ring);
+    }
+    {
+        MutexDequeQueue<std::shared_ptr<const HandoffState>> queue;
+        shared_ptr_handoff_benchmark("MutexDequeQueue<shared_ptr>", queue);
+    }
+
+    std::println();
+}
+
+constexpr unsigned kCONFLATION_KEYS = 1'000;
+constexpr unsigned kCONFLATION_PRODUCERS = 2;
+constexpr unsigned kCONFLATION_UPDATES = 200'000;  // per producer
+
+// Keys drawn from a Zipf distribution over kCONFLATION_KEYS with the given exponent; 0 is
+// uniform, around 1 a handful of hot keys take most of the updates.
+std::vector<unsigned> zipf_keys(const double exponent, const unsigned count, const unsigned seed) {
+    std::vector<double> cdf(kCONFLATION_KEYS);
+    double sum = 0;
+    for (unsigned k = 0; k < kCONFLATION_KEYS; ++k) cdf[k] = sum += 1.0 / std::pow(k + 1, exponent);
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(0, sum);
+    std::vector<unsigned> keys(count);
+    for (auto& key : keys)
+        key = static_cast<unsigned>(std::ranges::lower_bound(cdf, dist(gen)) - cdf.begin());
+    return keys;
+}
+
+// Producers stamp every update; the consumer spends ~200 ns per message it receives. Lag is the
+// age of each delivered value, i.e. how stale the consumer's view of that key is.
+template <typename Queue>
+void conflation_benchmark(char const* benchmark_name, const double exponent) {
+    Queue queue;
+    std::vector<std::vector<unsigned>> keys;
+    for (unsigned p = 0; p < kCONFLATION_PRODUCERS; ++p)
+        keys.push_back(zipf_keys(exponent, kCONFLATION_UPDATES, p + 1));
+    std::atomic<unsigned> producing = kCONFLATION_PRODUCERS;
+    std::vector<nano_t> lags;
+    lags.reserve(kCONFLATION_PRODUCERS * kCONFLATION_UPDATES);
+
+    std::thread consumer([&] {
+        typename Queue::value_type item;
+        for (;;) {
+            const bool finished = producing.load(std::memory_order::acquire) == 0;
+            if (!queue.try_pop(item)) {
+                if (finished) return;
+                continue;
+            }
+            lags.push_back(now_ns() - item.second);
+            const auto until = now_ns() + 200;
+            while (now_ns() < until) {}
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < kCONFLATION_PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            for (const unsigned key : keys[p]) queue.push({key, now_ns()});
+            producing.fetch_sub(1, std::memory_order::release);
+        });
+    }
+    for (auto& t : producers) t.join();
+    consumer.join();
+
+    std::ranges::sort(lags);
+    const auto pushed = double{kCONFLATION_PRODUCERS} * kCONFLATION_UPDATES;
+    std::println("{:<20} - zipf s={:.2f} - delivered: {:>7} - saved: {:>5.1f}% - lag p50: {:>9} ns "
+                 "- p99: {:>9} ns", benchmark_name, exponent, lags.size(),
+                 100.0 * (1.0 - static_cast<double>(lags.size()) / pushed),
+                 lags[lags.size() / 2], lags[lags.size() * 99 / 100]);
+}
+
+void conflation_benchmark_suite() {
+    std::println("----------- Keyed conflation under skewed load -----------");
+
+    for (const double exponent : {0.0, 0.8, 0.99, 1.2}) {
+        conflation_benchmark<ConflatingQueue<unsigned, nano_t>>("ConflatingQueue", exponent);
+        conflation_benchmark<MutexDequeQueue<std::pair<unsigned, nano_t>>>("MutexDequeQueue",
+                                                                           exponent);
+    }
+
+    std::println();
+}
+
+constexpr unsigned kBUS_MESSAGES = 10'000'000;
+
+// Three bus messages of very different sizes; 80% of the traffic is the smallest.
+struct Heartbeat {
+    std::uint64_t id;
+    std::uint64_t sent;
+};
+
+struct OrderUpdate {
+    std::uint64_t id;
+    std::uint64_t order_id;
+    double price;
+    double quantity;
+    std::uint32_t side;
+    char symbol[20];
+};
+
+struct BookSnapshot {
+    std::uint64_t id;
+    double bids[15];
+    double asks[15];
+    std::uint64_t depth;
+};
+
+using BusVariant = std::variant<Heartbeat, OrderUpdate, BookSnapshot>;
+using BusQueue = InplaceMessageQueue<1 << 20, Heartbeat, OrderUpdate, BookSnapshot>;
+
+struct BusMessage {
+    virtual ~BusMessage() = default;
+    [[nodiscard]] virtual std::uint64_t id() const = 0;
+};
+
+template <typename M>
+struct BoxedMessage final : BusMessage {
+    explicit BoxedMessage(const M& message) : message_(message) {}
+    [[nodiscard]] std::uint64_t id() const override { return message_.id; }
+    M message_;
+};
+
+// Calls send with the n-th message of the 80/15/5 heartbeat/order/snapshot mix.
+template <typename Send>
+void make_bus_message(const std::uint64_t n, Send&& send) {
+    if (n % 20 == 0)
+        send(BookSnapshot{n, {}, {}, 15});
+    else if (n % 20 < 4)
+        send(OrderUpdate{n, n, 100.25, 10, 1, "ESZ6"});
+    else
+        send(Heartbeat{n, n});
+}
+
+void print_bus_throughput(char const* benchmark_name, const nano_t duration,
+                          const std::uint64_t checksum) {
+    constexpr std::uint64_t expected = std::uint64_t{kBUS_MESSAGES} * (kBUS_MESSAGES - 1) / 2;
+    std::println("{:<44} - {:>6.2f} M msgs/s - {:>5.1f} ns/msg{}", benchmark_name,
+                 kBUS_MESSAGES * 1e3 / static_cast<double>(duration),
+                 static_cast<double>(duration) / kBUS_MESSAGES,
+                 checksum == expected ? "" : " - CHECKSUM MISMATCH");
+}
+
+void inplace_message_benchmark() {
+    auto queue = std::make_unique<BusQueue>();
+    std::uint64_t checksum = 0;
+    std::uint64_t received = 0;
+
+    const auto start = now_ns();
+    std::thread consumer([&] {
+        const auto visitor = [&](const auto& message) {
+            checksum += message.id;
+            ++received;
+        };
+        while (received < kBUS_MESSAGES) queue->consume_all(visitor);
+    });
+    for (std::uint64_t n = 0; n < kBUS_MESSAGES; ++n)
+        make_bus_message(n, [&](const auto& message) { queue->push(message); });
+    consumer.join();
+
+    print_bus_throughput("InplaceMessageQueue (1 MiB ring)", now_ns() - start, checksum);
+}
+
+void variant_message_benchmark() {
+    auto queue = std::make_unique<alpha::spsc<BusVariant, kQUEUE_SIZE>>();
+    std::uint64_t checksum = 0;
+
+    const auto start = now_ns();
+    std::thread consumer([&] {
+        BusVariant message;
+        for (std::uint64_t n = 0; n < kBUS_MESSAGES; ++n) {
+            queue->pop(message);
+            checksum += std::visit([](const auto& m) { return m.id; }, message);
+        }
+    });
+    for (std::uint64_t n = 0; n < kBUS_MESSAGES; ++n)
+        make_bus_message(n, [&](const auto& message) { queue->push(BusVariant(message)); });
+    consumer.join();
+
+    print_bus_throughput("alpha::spsc<variant>", now_ns() - start, checksum);
+}
+
+void unique_ptr_message_benchmark() {
+    MoodyCamelLockFreeQueue<std::unique_ptr<BusMessage>> queue(kQUEUE_SIZE);
+    std::uint64_t checksum = 0;
+
+    const auto start = now_ns();
+    std::thread consumer([&] {
+        std::unique_ptr<BusMessage> message;
+        for (std::uint64_t n = 0; n < kBUS_MESSAGES; ++n) {
+            queue.pop(message);
+            checksum += message->id();
+        }
+    });
+    for (std::uint64_t n = 0; n < kBUS_MESSAGES; ++n) {
+        make_bus_message(n, [&]<typename M>(const M& message) {
+            queue.push(std::make_unique<BoxedMessage<M>>(message));
+        });
+    }
+    consumer.join();
+
+    print_bus_throughput("MoodyCamelLockFreeQueue<unique_ptr<Base>>", now_ns() - start, checksum);
+}
+
+void heterogeneous_message_benchmark_suite() {
+    std::println("----------- Heterogeneous messages: in place vs variant vs boxed -----------");
+    std::println("bytes per message - in place: {} / {} / {} - variant: {}",
+                 BusQueue::record_size<Heartbeat>(), BusQueue::record_size<OrderUpdate>(),
+                 BusQueue::record_size<BookSnapshot>(), sizeof(BusVariant));
+
+    inplace_message_benchmark();
+    variant_message_benchmark();
+    unique_ptr_message_benchmark();
+
+    std::println();
+}
+
+constexpr std::size_t kCOPY_BYTES_PER_RUN = std::size_t{1} << 30;
+
+double gigabytes_per_second(const std::size_t bytes, const nano_t duration) {
+    return static_cast<double>(bytes) / static_cast<double>(duration);
+}
+
+// Copies a buffer of the given size until kCOPY_BYTES_PER_RUN bytes have moved.
+void copy_kernel_benchmark(char const* path_name, const simd::CopyFn copy,
+                           const simd::StoreHint hint, const std::size_t bytes) {
+    std::vector<std::byte> src(bytes, std::byte{1});
+    std::vector<std::byte> dst(bytes);
+    const std::size_t runs = std::max<std::size_t>(1, kCOPY_BYTES_PER_RUN / bytes);
+    copy(dst.data(), src.data(), bytes, hint);
+
+    const auto start = now_ns();
+    for (std::size_t run = 0; run < runs; ++run) {
+        copy(dst.data(), src.data(), bytes, hint);
+        asm volatile("" ::: "memory");
+    }
+    const auto duration = now_ns() - start;
+    std::println("{:<10} - {:>8} KiB - {:>6.2f} GB/s", path_name, bytes / 1024,
+                 gigabytes_per_second(runs * bytes, duration));
+}
+
+// Moves items through an alpha::spsc on one thread in batches, per element or in bulk.
+template <typename T>
+void ring_bulk_benchmark(char const* type_name, const bool bulk) {
+    constexpr std::size_t kBATCH = 1024;
+    auto queue = std::make_unique<alpha::spsc<T, kQUEUE_SIZE>>();
+    std::vector<T> in(kBATCH);
+    std::vector<T> out(kBATCH);
+    const std::size_t batches = kCOPY_BYTES_PER_RUN / (kBATCH * sizeof(T));
+
+    const auto start = now_ns();
+    for (std::size_t b = 0; b < batches; ++b) {
+        if (bulk) {
+            queue->try_push_bulk(in.data(), kBATCH);
+            queue->try_pop_bulk(out.data(), kBATCH);
+        } else {
+            for (const auto& item : in) queue->try_push(item);
+            for (auto& item : out) queue->try_pop(item);
+        }
+        asm volatile("" ::: "memory");
+    }
+    const auto duration = now_ns() - start;
+    std::println("alpha::spsc<{}> {:<12} - {:>6.2f} GB/s", type_name,
+                 bulk ? "bulk" : "per element",
+                 gigabytes_per_second(batches * kBATCH * sizeof(T), duration));
+}
+
+struct Quad {
+    std::uint32_t words[4];
+};
+
+void bulk_copy_benchmark_suite() {
+    std::println("----------- Bulk copy: scalar vs memcpy vs SIMD (dispatch picks {}) -----------",
+                 simd::copy_path_name());
+
+    const auto memcpy_copy = [](void* dst, const void* src, const std::size_t bytes,
+                                simd::StoreHint) { std::memcpy(dst, src, bytes); };
+    constexpr auto cached = simd::StoreHint::Cached;
+    // The kernels are called directly here, so each one is only run where the CPU can execute it.
+    __builtin_cpu_init();
+    const bool has_sse2 = __builtin_cpu_supports("sse2");
+    const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (!has_sse2) std::println("SSE2 rows skipped: not supported by this CPU");
+    if (!has_avx2) std::println("AVX2 rows skipped: not supported by this CPU");
+    for (const std::size_t bytes : {std::size_t{4} << 10, std::size_t{64} << 10,
+                                    std::size_t{1} << 20, std::size_t{64} << 20}) {
+        copy_kernel_benchmark("scalar", simd::copy_scalar, cached, bytes);
+        copy_kernel_benchmark("memcpy", memcpy_copy, cached, bytes);
+        if (has_sse2) copy_kernel_benchmark("SSE2", simd::copy_sse2, cached, bytes);
+        if (has_avx2) {
+            copy_kernel_benchmark("AVX2", simd::copy_avx2, cached, bytes);
+            copy_kernel_benchmark("AVX2 NT", simd::copy_avx2, simd::StoreHint::NonTemporal,
+                                  bytes);
+        }
+    }
+
+    ring_bulk_benchmark<std::uint32_t>("uint32_t", false);
+    ring_bulk_benchmark<std::uint32_t>("uint32_t", true);
+    ring_bulk_benchmark<Quad>("16 bytes", false);
+    ring_bulk_benchmark<Quad>("16 bytes", true);
+
+    std::println();
+}
+
+template <typename Queue>
+void mpsc_bulk_benchmark(char const* benchmark_name, unsigned int max_producer_count) {
+    run_benchmark_set<Queue, BenchmarkType::SingleBulkConsumer>(benchmark_name, 2,
+                                                                max_producer_count);
+}
+
+// Every queue the throughput and latency suites know about, holding items of type T. f is called
+// as f(std::type_identity<Queue>{}, name) and picks the topologies to run from the queue's
+// capability traits, so a queue added here shows up in each suite it can safely take part in.
+// Fifo1 is left out because it is not thread safe at all.
+template <typename T = unsigned, typename F>
+void for_each_queue(F&& f) {
+    f(std::type_identity<MutexDequeQueue<T>>{}, "MutexDequeQueue");
+    f(std::type_identity<MutexListQueue<T>>{}, "MutexListQueue");
+    f(std::type_identity<PooledQueue<pmr::MutexDequeQueue<T>>>{},
+      "pmr::MutexDequeQueue + NodePool");
+    f(std::type_identity<PooledQueue<pmr::MutexListQueue<T>>>{},
+      "pmr::MutexListQueue + NodePool");
+    f(std::type_identity<TwoLockQueue<T>>{}, "TwoLockQueue");
+    f(std::type_identity<MichaelScottQueue<T>>{}, "MichaelScottQueue");
+
+    f(std::type_identity<MutexRingBufferQueue<T>>{}, "MutexRingBufferQueue");
+    f(std::type_identity<MutexBoostRingBufferQueue<T>>{}, "MutexBoostRingBufferQueue");
+    f(std::type_identity<StdAtomicSPSCQueue<T, 16384>>{}, "StdAtomicSPSCQueue");
+    f(std::type_identity<StdAtomicMPMCQueue<T, 16384>>{}, "StdAtomicMPMCQueue");
+
+    f(std::type_identity<alpha::spsc<T, 16384>>{},
+      "alpha::spsc - all optimisations");
+    f(std::type_identity<bravo::spsc<T, 16384>>{},
+      "beta::spsc - with false sharing");
+    f(std::type_identity<charlie::spsc<T, 16384>>{},
+      "charlie::spsc - seq_cst mem order");
+    f(std::type_identity<delta::spsc<T, 16384>>{},
+      "delta::spsc - no cached head/tail");
+    f(std::type_identity<echo::spsc<T, 16384>>{},
+      "echo::spsc - array on heap not stack");
+    f(std::type_identity<alpha::spsc<T, 16385>>{},
+      "alpha::spsc - SIZE not power of 2");
+
+    f(std::type_identity<BoostLockFreeSPSCQueue<T, 16384>>{}, "BoostLockFreeSPSCQueue");
+    f(std::type_identity<BoostLockFreeQueue<T, 16384>>{}, "BoostLockFreeQueue");
+    f(std::type_identity<RigtorpSPSCAdapter<T>>{}, "rigtorp::SPSCQueue");
+
+    f(std::type_identity<MoodyCamelBlockingQueue<T>>{}, "MoodyCamelBlockingQueue");
+    f(std::type_identity<MoodyCamelLockFreeQueue<T>>{}, "MoodyCamelLockFreeQueue");
+
+    f(std::type_identity<AtomicQueueSPSCAdapter<T, 16384>>{}, "AtomicQueue(SPSC=true)");
+    f(std::type_identity<AtomicQueueAdapter<T, 16384>>{}, "AtomicQueue");
+    f(std::type_identity<OptimistAtomicQueueSPSCAdapter<T, 16384>>{},
+      "OptimistAtomicQueue(SPSC=true)");
+    f(std::type_identity<OptimistAtomicQueueAdapter<T, 16384>>{}, "OptimistAtomicQueue");
+
+    f(std::type_identity<fifo2_adapter<T, 16384>>{}, "cppcon fifo2 (atomics)");
+    f(std::type_identity<fifo3_adapter<T, 16384>>{},
+      "cppcon fifo3 (memory orders, false sharing)");
+    f(std::type_identity<fifo4_adapter<T, 16384>>{}, "cppcon fifo4 (cached head/tail)");
+}
+
+// Lossy queues are left out of every throughput suite: the consumers count items and stop flags,
+// so a dropped or merged item would leave them waiting forever.
+void spsc_benchmark_suite() {
+    std::println("----------- SPSC Benchmarks -----------");
+
+    for_each_queue([]<typename Queue>(std::type_identity<Queue>, char const* name) {
+        if constexpr (!is_lossy_v<Queue>) spsc_benchmark<Queue>(name);
+    });
 
     std::println();
 }
@@ -364,21 +1772,88 @@ void spsc_benchmark_suite() {
 void mpmc_benchmark_suite() {
     std::println("----------- MPMC Benchmarks -----------");
 
-    mpmc_benchmark<MutexDequeQueue<unsigned>>("MutexDequeQueue", 2, 6);
-    // mpmc_benchmark<MutexListQueue<unsigned>>("MutexListQueue", 2, 6);
+    for_each_queue([]<typename Queue>(std::type_identity<Queue>, char const* name) {
+        if constexpr (!is_lossy_v<Queue> && max_producers_v<Queue> > 1 &&
+                      max_consumers_v<Queue> > 1) {
+            mpmc_benchmark<Queue>(
+                name, 2, std::min({6u, max_producers_v<Queue>, max_consumers_v<Queue>}));
+        }
+    });
 
-    // mpmc_benchmark<MutexRingBufferQueue<unsigned>>("MutexRingBufferQueue", 2, 6);
-    // mpmc_benchmark<MutexBoostRingBufferQueue<unsigned>>("MutexBoostRingBufferQueue", 2, 6);
-    // mpmc_benchmark<StdAtomicSPSCQueue<unsigned, 16384>>("StdAtomicSPSCQueue", 2, 6);
-    mpmc_benchmark<StdAtomicMPMCQueue<unsigned, 16384>>("StdAtomicMPMCQueue", 2, 6);
+    std::println();
+}
 
-    mpmc_benchmark<BoostLockFreeQueue<unsigned, 16384>>("BoostLockFreeQueue", 2, 6);
+void lock_policy_benchmark_suite() {
+    using atomic_queue::Spinlock;
+    using atomic_queue::TicketSpinlock;
+    using atomic_queue::UnfairSpinlock;
+
+    std::println("----------- MPMC Lock Policy Benchmarks -----------");
+
+    mpmc_benchmark<MutexDequeQueue<unsigned, std::mutex>>("MutexDequeQueue<std::mutex>", 2, 6);
+    mpmc_benchmark<MutexDequeQueue<unsigned, Spinlock>>("MutexDequeQueue<Spinlock>", 2, 6);
+    mpmc_benchmark<MutexDequeQueue<unsigned, TicketSpinlock>>("MutexDequeQueue<TicketSpinlock>",
+                                                              2, 6);
+    mpmc_benchmark<MutexDequeQueue<unsigned, UnfairSpinlock>>("MutexDequeQueue<UnfairSpinlock>",
+                                                              2, 6);
+    mpmc_benchmark<MutexDequeQueue<unsigned, AdaptiveMutex>>("MutexDequeQueue<AdaptiveMutex>", 2,
+                                                             6);
+
+    mpmc_benchmark<MutexRingBufferQueue<unsigned, std::mutex>>("MutexRingBufferQueue<std::mutex>",
+                                                               2, 6);
+    mpmc_benchmark<MutexRingBufferQueue<unsigned, Spinlock>>("MutexRingBufferQueue<Spinlock>", 2,
+                                                             6);
+    mpmc_benchmark<MutexRingBufferQueue<unsigned, TicketSpinlock>>(
+        "MutexRingBufferQueue<TicketSpinlock>", 2, 6);
+    mpmc_benchmark<MutexRingBufferQueue<unsigned, UnfairSpinlock>>(
+        "MutexRingBufferQueue<UnfairSpinlock>", 2, 6);
+    mpmc_benchmark<MutexRingBufferQueue<unsigned, AdaptiveMutex>>(
+        "MutexRingBufferQueue<AdaptiveMutex>", 2, 6);
 
-    // mpmc_benchmark<MoodyCamelBlockingQueue<unsigned>>("MoodyCamelBlockingQueue", 2, 6);
-    // mpmc_benchmark<MoodyCamelLockFreeQueue<unsigned>>("MoodyCamelLockFreeQueue", 2, 6);
+    std::println();
+}
 
-    mpmc_benchmark<AtomicQueueAdapter<unsigned, 16384>>("AtomicQueue", 2, 6);
-    // mpmc_benchmark<OptimistAtomicQueueAdapter<unsigned, 16384>>("OptimistAtomicQueue", 2, 6);
+void notify_policy_benchmark_suite() {
+    std::println("----------- Notify Policy Benchmarks -----------");
+
+    spsc_benchmark<MutexDequeQueue<unsigned, std::mutex, AlwaysNotify>>(
+        "MutexDequeQueue<AlwaysNotify>");
+    spsc_benchmark<MutexDequeQueue<unsigned, std::mutex, NotifyWaiters>>(
+        "MutexDequeQueue<NotifyWaiters>");
+    spsc_benchmark<MutexDequeQueue<unsigned, std::mutex, BatchedNotify<64>>>(
+        "MutexDequeQueue<BatchedNotify<64>>");
+    mpmc_benchmark<MutexDequeQueue<unsigned, std::mutex, AlwaysNotify>>(
+        "MutexDequeQueue<AlwaysNotify>", 2, 6);
+    mpmc_benchmark<MutexDequeQueue<unsigned, std::mutex, NotifyWaiters>>(
+        "MutexDequeQueue<NotifyWaiters>", 2, 6);
+    mpmc_benchmark<MutexDequeQueue<unsigned, std::mutex, BatchedNotify<64>>>(
+        "MutexDequeQueue<BatchedNotify<64>>", 2, 6);
+
+    spsc_benchmark<MutexRingBufferQueue<unsigned, std::mutex, AlwaysNotify>>(
+        "MutexRingBufferQueue<AlwaysNotify>");
+    spsc_benchmark<MutexRingBufferQueue<unsigned, std::mutex, NotifyWaiters>>(
+        "MutexRingBufferQueue<NotifyWaiters>");
+    spsc_benchmark<MutexRingBufferQueue<unsigned, std::mutex, BatchedNotify<64>>>(
+        "MutexRingBufferQueue<BatchedNotify<64>>");
+    mpmc_benchmark<MutexRingBufferQueue<unsigned, std::mutex, AlwaysNotify>>(
+        "MutexRingBufferQueue<AlwaysNotify>", 2, 6);
+    mpmc_benchmark<MutexRingBufferQueue<unsigned, std::mutex, NotifyWaiters>>(
+        "MutexRingBufferQueue<NotifyWaiters>", 2, 6);
+    mpmc_benchmark<MutexRingBufferQueue<unsigned, std::mutex, BatchedNotify<64>>>(
+        "MutexRingBufferQueue<BatchedNotify<64>>", 2, 6);
+
+    spsc_benchmark<MutexBoostRingBufferQueue<unsigned, AlwaysNotify>>(
+        "MutexBoostRingBufferQueue<AlwaysNotify>");
+    spsc_benchmark<MutexBoostRingBufferQueue<unsigned, NotifyWaiters>>(
+        "MutexBoostRingBufferQueue<NotifyWaiters>");
+    spsc_benchmark<MutexBoostRingBufferQueue<unsigned, BatchedNotify<64>>>(
+        "MutexBoostRingBufferQueue<BatchedNotify<64>>");
+    mpmc_benchmark<MutexBoostRingBufferQueue<unsigned, AlwaysNotify>>(
+        "MutexBoostRingBufferQueue<AlwaysNotify>", 2, 6);
+    mpmc_benchmark<MutexBoostRingBufferQueue<unsigned, NotifyWaiters>>(
+        "MutexBoostRingBufferQueue<NotifyWaiters>", 2, 6);
+    mpmc_benchmark<MutexBoostRingBufferQueue<unsigned, BatchedNotify<64>>>(
+        "MutexBoostRingBufferQueue<BatchedNotify<64>>", 2, 6);
 
     std::println();
 }
@@ -386,38 +1861,656 @@ void mpmc_benchmark_suite() {
 void spmc_benchmark_suite() {
     std::println("----------- SPMC Benchmarks -----------");
 
-    spmc_benchmark<MutexDequeQueue<unsigned>>("MutexDequeQueue", 4);
-    spmc_benchmark<MutexListQueue<unsigned>>("MutexListQueue", 4);
+    for_each_queue([]<typename Queue>(std::type_identity<Queue>, char const* name) {
+        if constexpr (!is_lossy_v<Queue> && max_consumers_v<Queue> > 1)
+            spmc_benchmark<Queue>(name, std::min(4u, max_consumers_v<Queue>));
+    });
 
-    spmc_benchmark<BoostLockFreeQueue<unsigned, 16384>>("BoostLockFreeQueue", 4);
+    std::println();
+}
 
-    spmc_benchmark<MoodyCamelBlockingQueue<unsigned>>("MoodyCamelBlockingQueue", 4);
-    spmc_benchmark<MoodyCamelLockFreeQueue<unsigned>>("MoodyCamelLockFreeQueue", 4);
+// Queues with a batch interface (pop_all() or try_pop_bulk()) also run with a bulk consumer.
+void mpsc_benchmark_suite() {
+    std::println("----------- MPSC Benchmarks -----------");
 
-    spmc_benchmark<AtomicQueueAdapter<unsigned, 16384>>("AtomicQueue", 4);
+    for_each_queue([]<typename Queue>(std::type_identity<Queue>, char const* name) {
+        if constexpr (!is_lossy_v<Queue> && max_producers_v<Queue> > 1) {
+            const unsigned producers = std::min(4u, max_producers_v<Queue>);
+            mpsc_benchmark<Queue>(name, producers);
+            if constexpr (BulkPopQueue<Queue>) {
+                const std::string bulk_name =
+                    std::string(name) + (PopAllQueue<Queue> ? " (pop_all)" : " (try_pop_bulk)");
+                mpsc_bulk_benchmark<Queue>(bulk_name.c_str(), producers);
+            }
+        }
+    });
 
     std::println();
 }
 
-void mpsc_benchmark_suite() {
-    std::println("----------- MPSC Benchmarks -----------");
+constexpr unsigned kLATENCY_MESSAGES = 1'000'000;  // per producer
+constexpr nano_t kLATENCY_SEND_INTERVAL_NS = 1'000;  // per producer
+
+// Latency-mode item carrying the time its producer meant to send it. It stays eight bytes so the
+// queues that need lock-free atomic elements can carry it, and a stamp is never zero, which keeps
+// it clear of atomic_queue's NIL value.
+struct TimedItem {
+    nano_t sent_ns = 0;
+
+    friend bool operator==(const TimedItem&, const TimedItem&) = default;
+};
+
+constexpr TimedItem kLATENCY_STOP{std::numeric_limits<nano_t>::max()};
 
-    mpsc_benchmark<MutexDequeQueue<unsigned>>("MutexDequeQueue", 4);
-    mpsc_benchmark<MutexListQueue<unsigned>>("MutexListQueue", 4);
+// Sends on a fixed schedule and stamps each message with its scheduled time rather than the time
+// push() got to run, so a producer held up by a full queue or by the scheduler charges the delay
+// to the messages it postponed instead of hiding it. The last producer to finish pushes one stop
+// item per consumer.
+template <typename Queue>
+void timed_producer(Queue& queue, Barrier& barrier, std::atomic<unsigned>& active_producers,
+                    const unsigned consumer_count) {
+    barrier.wait();
+
+    const nano_t start = now_ns();
+    for (unsigned n = 1; n <= kLATENCY_MESSAGES; ++n) {
+        const nano_t scheduled = start + n * kLATENCY_SEND_INTERVAL_NS;
+        while (now_ns() < scheduled) _mm_pause();
+        queue.push(TimedItem{scheduled});
+    }
+
+    if (1 == active_producers.fetch_sub(1, std::memory_order::acq_rel))
+        for (unsigned i = 0; i < consumer_count; ++i) queue.push(kLATENCY_STOP);
+}
+
+template <typename Queue>
+void timed_consumer(Queue& queue, Barrier& barrier, LatencyHistogram& histogram) {
+    barrier.wait();
+
+    for (;;) {
+        TimedItem item;
+        queue.pop(item);
+        const nano_t received = now_ns();
+        if (item == kLATENCY_STOP) break;
+        histogram.record(static_cast<std::uint64_t>(received - item.sent_ns));
+    }
+}
+
+// Each consumer records into its own histogram; they are merged once every thread has joined.
+template <typename Queue>
+LatencyHistogram latency_benchmark_iteration(const unsigned producer_count,
+                                             const unsigned consumer_count) {
+    Barrier barrier;
+    std::vector<std::thread> threads;
+    std::vector<LatencyHistogram> histograms(consumer_count);
+    std::atomic<unsigned> active_producers{producer_count};
+    auto queue = createQueue<Queue>();
+
+    for (unsigned i = 0; i < producer_count; ++i) {
+        threads.emplace_back(timed_producer<Queue>, std::ref(queue), std::ref(barrier),
+                             std::ref(active_producers), consumer_count);
+    }
+    for (unsigned i = 0; i < consumer_count; ++i) {
+        threads.emplace_back(timed_consumer<Queue>, std::ref(queue), std::ref(barrier),
+                             std::ref(histograms[i]));
+    }
+
+    barrier.release(producer_count + consumer_count);
+    for (auto& t : threads) t.join();
+
+    LatencyHistogram merged;
+    for (const auto& histogram : histograms) merged.merge(histogram);
+    return merged;
+}
+
+void print_latency_histogram(char const* benchmark_name, const unsigned producer_count,
+                             const unsigned consumer_count, const LatencyHistogram& histogram) {
+    std::println("{:<40} {}P/{}C - p50: {:>7} - p90: {:>7} - p99: {:>7} - p99.9: {:>8}"
+                 " - p99.99: {:>8} - max: {:>9} ns",
+                 benchmark_name, producer_count, consumer_count, histogram.percentile(50),
+                 histogram.percentile(90), histogram.percentile(99), histogram.percentile(99.9),
+                 histogram.percentile(99.99), histogram.max());
+}
+
+// Enqueue-to-dequeue latency per message at a fixed offered load, for every queue in each
+// topology its traits allow.
+void latency_benchmark_suite() {
+    struct Topology {
+        unsigned producers;
+        unsigned consumers;
+    };
+    constexpr Topology kTOPOLOGIES[] = {{1, 1}, {2, 2}, {1, 3}, {3, 1}};
+
+    std::println("----------- Per-message latency, {} msg/s per producer -----------",
+                 format_number(static_cast<long>(1e9 / kLATENCY_SEND_INTERVAL_NS)));
+
+    for_each_queue<TimedItem>([&]<typename Queue>(std::type_identity<Queue>, char const* name) {
+        if constexpr (!is_lossy_v<Queue>) {
+            for (const auto [producers, consumers] : kTOPOLOGIES) {
+                if (producers > max_producers_v<Queue> || consumers > max_consumers_v<Queue>)
+                    continue;
+                const auto histogram = latency_benchmark_iteration<Queue>(producers, consumers);
+                print_latency_histogram(name, producers, consumers, histogram);
+                results.add_percentiles(record_for<Queue>("latency", name, producers, consumers),
+                                        histogram);
+            }
+        }
+    });
+
+    std::println();
+}
+
+constexpr unsigned kRTT_WARMUP_ROUNDS = 10'000;
+constexpr unsigned kRTT_ROUNDS = 200'000;
+
+// One message in flight between two pinned threads over a ping queue and a pong queue of the
+// same type. The initiator times each round trip on its own clock, so no cross-core clock
+// comparison is involved. Items start at 1 because atomic_queue reserves 0 as its NIL value.
+template <typename Queue>
+LatencyHistogram ping_pong_rtt_benchmark(const int initiator_cpu, const int responder_cpu) {
+    auto ping = createQueue<Queue>();
+    auto pong = createQueue<Queue>();
+    LatencyHistogram histogram;
+
+    std::thread responder([&] {
+        pinThread(responder_cpu);
+        typename Queue::value_type item;
+        for (unsigned n = 0; n < kRTT_WARMUP_ROUNDS + kRTT_ROUNDS; ++n) {
+            ping.pop(item);
+            pong.push(item);
+        }
+    });
+    std::thread initiator([&] {
+        pinThread(initiator_cpu);
+        typename Queue::value_type item;
+        for (unsigned n = 1; n <= kRTT_WARMUP_ROUNDS + kRTT_ROUNDS; ++n) {
+            const nano_t start = now_ns();
+            ping.push(n);
+            pong.pop(item);
+            if (n > kRTT_WARMUP_ROUNDS)
+                histogram.record(static_cast<std::uint64_t>(now_ns() - start));
+        }
+    });
+
+    initiator.join();
+    responder.join();
+    return histogram;
+}
+
+void print_rtt_histogram(char const* benchmark_name, const LatencyHistogram& histogram) {
+    std::println("{:<45} - min: {:>6} - p50: {:>6} - p90: {:>6} - p99: {:>7} - p99.9: {:>8}"
+                 " - max: {:>9} ns",
+                 benchmark_name, histogram.min(), histogram.percentile(50),
+                 histogram.percentile(90), histogram.percentile(99), histogram.percentile(99.9),
+                 histogram.max());
+}
+
+// Round-trip time for every SPSC queue and every blocking queue. The two threads go on cores 0
+// and 1 when the machine has them, so the pair shares whatever cache level those cores do.
+void ping_pong_rtt_benchmark_suite() {
+    // The two lowest CPUs this process may run on; a side with no CPU of its own stays unpinned.
+    const auto cpus = allowed_cpus();
+    const int initiator_cpu = cpus.size() > 0 ? cpus[0] : -1;
+    const int responder_cpu = cpus.size() > 1 ? cpus[1] : -1;
+    const auto cpu_name = [](const int cpu) {
+        return cpu < 0 ? std::string("unpinned") : "cpu " + std::to_string(cpu);
+    };
+    std::println("----------- Ping-pong round trip, {} <-> {} -----------",
+                 cpu_name(initiator_cpu), cpu_name(responder_cpu));
+
+    for_each_queue([&]<typename Queue>(std::type_identity<Queue>, char const* name) {
+        if constexpr (SpscQueue<Queue> || BlockingQueue<Queue>) {
+            const auto histogram = ping_pong_rtt_benchmark<Queue>(initiator_cpu, responder_cpu);
+            print_rtt_histogram(name, histogram);
+            results.add_percentiles(record_for<Queue>("rtt", name, 1, 1), histogram);
+        }
+    });
+
+    std::println();
+}
+
+constexpr unsigned kC2C_ROUNDS = 20'000;
+
+// One atomic on a cache line of its own, as alpha::spsc lays out head_ and tail_.
+struct C2CLine {
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> value_{0};
+    char padding_[CACHE_LINE_SIZE - sizeof(std::atomic<std::uint64_t>)];
+};
+
+// Average one-way cost of moving a cache line between two CPUs: the threads take turns bumping
+// the same atomic, so every round is two transfers. Best of three runs.
+double core_to_core_ns(const int first_cpu, const int second_cpu) {
+    constexpr unsigned RUNS = 3;
+    double best = std::numeric_limits<double>::max();
+
+    for (unsigned run = 0; run < RUNS; ++run) {
+        C2CLine line;
+        nano_t duration = 0;
+        // Both threads pin themselves and then meet here, spinning rather than sleeping, so
+        // neither thread start-up nor a migration nor a wake-up lands in the timed rounds.
+        std::latch pinned(2);
+        const auto meet = [&] {
+            pinned.count_down();
+            while (!pinned.try_wait()) _mm_pause();
+        };
+        std::thread responder([&] {
+            pinThread(second_cpu);
+            meet();
+            for (std::uint64_t n = 0; n < kC2C_ROUNDS; ++n) {
+                while (line.value_.load(std::memory_order::acquire) != 2 * n + 1) _mm_pause();
+                line.value_.store(2 * n + 2, std::memory_order::release);
+            }
+        });
+        std::thread initiator([&] {
+            pinThread(first_cpu);
+            meet();
+            const nano_t start = now_ns();
+            for (std::uint64_t n = 0; n < kC2C_ROUNDS; ++n) {
+                line.value_.store(2 * n + 1, std::memory_order::release);
+                while (line.value_.load(std::memory_order::acquire) != 2 * n + 2) _mm_pause();
+            }
+            duration = now_ns() - start;
+        });
+        initiator.join();
+        responder.join();
+        best = std::min(best, static_cast<double>(duration) / (2.0 * kC2C_ROUNDS));
+    }
+    return best;
+}
+
+// Symmetric matrix of core_to_core_ns() over every pair of CPUs, indexed like cpus.
+std::vector<std::vector<double>> core_to_core_matrix(const std::vector<CpuInfo>& cpus) {
+    std::vector matrix(cpus.size(), std::vector<double>(cpus.size(), 0.0));
+    for (std::size_t i = 0; i < cpus.size(); ++i) {
+        for (std::size_t j = i + 1; j < cpus.size(); ++j)
+            matrix[i][j] = matrix[j][i] = core_to_core_ns(cpus[i].cpu, cpus[j].cpu);
+    }
+    return matrix;
+}
+
+// Prints the core-to-core matrix for every CPU this process may use and, given csv_path, writes
+// it there too, with the CPU numbers as the first row and column.
+void core_to_core_benchmark_suite(char const* csv_path = nullptr) {
+    const auto cpus = CpuTopology::detect().cpus();
+    std::println("----------- Core-to-core cache line transfer, ns one way -----------");
+    const auto matrix = core_to_core_matrix(cpus);
 
-    mpsc_benchmark<BoostLockFreeQueue<unsigned, 16384>>("BoostLockFreeQueue", 4);
+    std::print("{:>5}", "");
+    for (const auto& cpu : cpus) std::print("{:>6}", cpu.cpu);
+    std::println();
+    for (std::size_t i = 0; i < cpus.size(); ++i) {
+        std::print("{:>5}", cpus[i].cpu);
+        for (std::size_t j = 0; j < cpus.size(); ++j) {
+            if (i == j)
+                std::print("{:>6}", "-");
+            else
+                std::print("{:>6.0f}", matrix[i][j]);
+        }
+        std::println();
+    }
+
+    if (csv_path) {
+        std::ofstream csv(csv_path);
+        csv << "cpu";
+        for (const auto& cpu : cpus) csv << ',' << cpu.cpu;
+        csv << '\n';
+        for (std::size_t i = 0; i < cpus.size(); ++i) {
+            csv << cpus[i].cpu;
+            for (std::size_t j = 0; j < cpus.size(); ++j) {
+                csv << ',';
+                if (i != j) csv << std::fixed << std::setprecision(1) << matrix[i][j];
+            }
+            csv << '\n';
+        }
+        std::println("written to {}", csv_path);
+    }
+
+    std::println();
+}
+
+// Runs the 1P/1C throughput and round-trip benchmarks with the pair of threads placed each way
+// the machine's topology allows, so results can be compared across placements instead of varying
+// with wherever the scheduler happened to put the threads.
+void placement_benchmark_suite() {
+    const auto topology = CpuTopology::detect();
+    std::println("----------- Placement sweep over {} usable CPUs -----------",
+                 topology.cpus().size());
+
+    for (const auto placement : kALL_PLACEMENTS) {
+        const auto cpus = topology.pair(placement);
+        if (!cpus) {
+            std::println("[{}] not available on this machine\n", placement_name(placement));
+            continue;
+        }
+        // Labels name the placement and CPUs only, so recorded results line up across runs; the
+        // pair's entry in the core-to-core matrix goes in the heading instead.
+        std::string label = std::string("[") + placement_name(placement);
+        if (placement != Placement::Unpinned) {
+            label += ' ' + std::to_string(cpus->first) + ',' + std::to_string(cpus->second);
+            std::println("{}: core-to-core {} ns", label + ']',
+                         std::lround(core_to_core_ns(cpus->first, cpus->second)));
+        }
+        label += "] ";
+
+        spsc_placement = *cpus;
+        for_each_queue([&]<typename Queue>(std::type_identity<Queue>, char const* name) {
+            const std::string labelled = label + name;
+            if constexpr (!is_lossy_v<Queue>) spsc_benchmark<Queue>(labelled.c_str());
+            if constexpr (SpscQueue<Queue> || BlockingQueue<Queue>) {
+                const auto histogram = ping_pong_rtt_benchmark<Queue>(cpus->first, cpus->second);
+                print_rtt_histogram(labelled.c_str(), histogram);
+                results.add_percentiles(record_for<Queue>("rtt", labelled.c_str(), 1, 1),
+                                        histogram);
+            }
+        });
+        std::println();
+    }
+    spsc_placement = {};
+}
+
+// Fixed-size benchmark element: a sequence number, filler derived from it, and a checksum over
+// both, so the producer writes and the consumer reads every byte and a torn or corrupted copy is
+// caught. Sequence 0 is never sent, which keeps it clear of atomic_queue's NIL value.
+template <std::size_t BYTES>
+struct Payload {
+    static_assert(BYTES >= 8 && BYTES % sizeof(std::uint32_t) == 0);
+    static constexpr std::uint32_t kSTOP = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t kWORDS = BYTES / sizeof(std::uint32_t);
+
+    static Payload make(const std::uint32_t sequence) {
+        Payload payload;
+        payload.words_[0] = sequence;
+        for (std::size_t i = 1; i + 1 < kWORDS; ++i)
+            payload.words_[i] = sequence * 0x9E3779B1u + static_cast<std::uint32_t>(i);
+        payload.words_[kWORDS - 1] = payload.checksum();
+        return payload;
+    }
 
-    mpsc_benchmark<MoodyCamelBlockingQueue<unsigned>>("MoodyCamelBlockingQueue", 4);
-    mpsc_benchmark<MoodyCamelLockFreeQueue<unsigned>>("MoodyCamelLockFreeQueue", 4);
+    [[nodiscard]] std::uint32_t sequence() const { return words_[0]; }
+    [[nodiscard]] bool valid() const { return words_[kWORDS - 1] == checksum(); }
+
+    [[nodiscard]] std::uint32_t checksum() const {
+        std::uint32_t sum = 0x2545F491u;
+        for (std::size_t i = 0; i + 1 < kWORDS; ++i) sum = (sum ^ words_[i]) * 0x01000193u;
+        return sum;
+    }
+
+    friend bool operator==(const Payload&, const Payload&) = default;
+
+    std::uint32_t words_[kWORDS];
+};
+
+static_assert(sizeof(Payload<8>) == 8 && sizeof(Payload<4096>) == 4096);
+
+// Bytes each payload size moves per run, within the item count limits below.
+constexpr std::uint64_t kPAYLOAD_BYTES_PER_RUN = 2ULL << 30;
+
+// On the heap, since rings of 16K large payloads are far too big for a thread's stack.
+template <typename Queue>
+std::unique_ptr<Queue> createQueueOnHeap() {
+    if constexpr (is_bounded_v<Queue>)
+        return std::make_unique<Queue>(kQUEUE_SIZE);
+    else
+        return std::make_unique<Queue>();
+}
+
+// 1P/1C transfer of items payloads; counts the ones that arrive with a bad checksum.
+template <typename Queue>
+nano_t payload_benchmark_iteration(const std::uint32_t items, std::uint64_t& corrupt) {
+    using Item = typename Queue::value_type;
+    const auto queue = createQueueOnHeap<Queue>();
+    Barrier barrier;
+    nano_t start = 0;
+    nano_t end = 0;
 
-    mpsc_benchmark<AtomicQueueAdapter<unsigned, 16384>>("AtomicQueue", 4);
+    std::thread producer_thread([&] {
+        pinThread(spsc_placement.first);
+        barrier.wait();
+        start = now_ns();
+        for (std::uint32_t n = 1; n <= items; ++n) queue->push(Item::make(n));
+        queue->push(Item::make(Item::kSTOP));
+    });
+    std::thread consumer_thread([&] {
+        pinThread(spsc_placement.second);
+        barrier.wait();
+        Item item;
+        for (;;) {
+            queue->pop(item);
+            if (item.sequence() == Item::kSTOP) break;
+            if (!item.valid()) ++corrupt;
+        }
+        end = now_ns();
+    });
+
+    barrier.release(2);
+    producer_thread.join();
+    consumer_thread.join();
+    return end - start;
+}
 
+template <std::size_t BYTES>
+void payload_benchmark_set() {
+    using Item = Payload<BYTES>;
+    const auto items = static_cast<std::uint32_t>(
+        std::clamp<std::uint64_t>(kPAYLOAD_BYTES_PER_RUN / BYTES, 1'000'000, 100'000'000));
+    std::println("{} byte payload, {} items per run", BYTES,
+                 format_number(static_cast<long>(items)));
+
+    for_each_queue<Item>([&]<typename Queue>(std::type_identity<Queue>, char const* name) {
+        if constexpr (!is_lossy_v<Queue>) {
+            std::uint64_t corrupt = 0;
+            const auto summary = stats::run_until_stable(
+                runner_config,
+                [&] {
+                    const auto duration = payload_benchmark_iteration<Queue>(items, corrupt);
+                    return static_cast<double>(items) / (static_cast<double>(duration) / 1e9);
+                },
+                [] {});
+
+            const auto gigabytes = [](const double messages_per_second) {
+                return messages_per_second * BYTES / 1e9;
+            };
+            std::println("{:<45} - median: {:>12} msg/s {:>6.2f} GB/s"
+                         " - max: {:>12} msg/s {:>6.2f} GB/s - CI: +/-{:.2f}%",
+                         name, format_number(static_cast<long>(summary.median)),
+                         gigabytes(summary.median), format_number(static_cast<long>(summary.max)),
+                         gigabytes(summary.max), 100.0 * summary.ci_half_width());
+            if (corrupt != 0) std::println("   ERROR: {} payloads failed their checksum", corrupt);
+            record_result<Queue>("payload", name, 1, 1, summary);
+        }
+    });
     std::println();
 }
 
+// 1P/1C throughput of every queue with payloads from one word to a page, where slot padding and
+// copy costs start to outweigh synchronisation.
+void payload_size_benchmark_suite() {
+    std::println("----------- Payload size sweep, 1 producer 1 consumer -----------");
+
+    payload_benchmark_set<8>();
+    payload_benchmark_set<16>();
+    payload_benchmark_set<64>();
+    payload_benchmark_set<256>();
+    payload_benchmark_set<1024>();
+    payload_benchmark_set<4096>();
+}
+
+// Where core_to_core_benchmark_suite() writes its matrix; set by --c2c-csv.
+std::string core_to_core_csv;
+
+struct Suite {
+    char const* name;
+    void (*run)();
+};
+
+constexpr Suite kSUITES[] = {
+    {"lock_hold", lock_hold_benchmark_suite},
+    {"coroutine_ping_pong", coroutine_ping_pong_benchmark_suite},
+    {"wakeup_latency", wakeup_latency_benchmark_suite},
+    {"fan_in", fan_in_benchmark_suite},
+    {"thread_pool", thread_pool_benchmark_suite},
+    {"pipeline", pipeline_benchmark_suite},
+    {"overload", overload_benchmark_suite},
+    {"broadcast", broadcast_benchmark_suite},
+    {"state_handoff", state_handoff_benchmark_suite},
+    {"conflation", conflation_benchmark_suite},
+    {"heterogeneous_message", heterogeneous_message_benchmark_suite},
+    {"bulk_copy", bulk_copy_benchmark_suite},
+    {"latency", latency_benchmark_suite},
+    {"ping_pong_rtt", ping_pong_rtt_benchmark_suite},
+    {"core_to_core",
+     [] {
+         core_to_core_benchmark_suite(core_to_core_csv.empty() ? nullptr
+                                                               : core_to_core_csv.c_str());
+     }},
+    {"placement", placement_benchmark_suite},
+    {"payload_size", payload_size_benchmark_suite},
+    {"spsc", spsc_benchmark_suite},
+    {"mpmc", mpmc_benchmark_suite},
+    {"lock_policy", lock_policy_benchmark_suite},
+    {"notify_policy", notify_policy_benchmark_suite},
+    {"spmc", spmc_benchmark_suite},
+    {"mpsc", mpsc_benchmark_suite},
+};
+
+// Exit statuses other than success.
+constexpr int kEXIT_REGRESSION = 1;
+constexpr int kEXIT_USAGE = 2;
+constexpr int kEXIT_BAD_BASELINE = 3;
+
+void print_usage(char const* program) {
+    std::println(stderr,
+                 "usage: {} [options] [suite...]\n"
+                 "  --list                 list the suites (default: spsc)\n"
+                 "  --json FILE            write the results as JSON\n"
+                 "  --csv FILE             write the results as CSV\n"
+                 "  --baseline FILE        compare against a CSV written by --csv\n"
+                 "  --threshold FRACTION   smallest change --baseline flags (default: 0.02)\n"
+                 "  --warmup N             discarded runs per set\n"
+                 "  --min-runs N           measured runs per set, at least\n"
+                 "  --max-runs N           measured runs per set, at most\n"
+                 "  --target-ci FRACTION   stop once the CI half-width is within this fraction\n"
+                 "  --time-budget SECONDS  stop adding runs to a set after this long\n"
+                 "  --c2c-csv FILE         where the core_to_core suite writes its matrix\n"
+                 "exit status: {} when a result is significantly worse than the baseline,\n"
+                 "{} for a bad command line, {} when the baseline cannot be read",
+                 program, kEXIT_REGRESSION, kEXIT_USAGE, kEXIT_BAD_BASELINE);
+}
+
+// Read before any suite runs, so a bad path fails in seconds rather than after the benchmarks.
+std::optional<std::vector<BenchmarkRecord>> load_baseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::println(stderr, "cannot open baseline {}", path);
+        return std::nullopt;
+    }
+    try {
+        auto baseline = BenchmarkResults::read_csv(file);
+        if (baseline.empty()) {
+            std::println(stderr, "baseline {} holds no results", path);
+            return std::nullopt;
+        }
+        return baseline;
+    } catch (const std::exception& e) {
+        std::println(stderr, "cannot parse baseline {}: {}", path, e.what());
+        return std::nullopt;
+    }
+}
+
+// Prints every result the baseline also has and returns how many got significantly worse. Meant
+// to run after bumping a vendored queue, on the same machine and build as the baseline.
+std::size_t compare_with_baseline(const std::vector<BenchmarkRecord>& baseline,
+                                  const std::string& path, const double threshold) {
+    const auto comparisons = compare(baseline, results.records(), threshold);
+
+    std::println("----------- Comparison with {} -----------", path);
+    std::size_t regressions = 0;
+    for (const auto& c : comparisons) {
+        char const* verdict = c.verdict == Verdict::Regression    ? " REGRESSION"
+                              : c.verdict == Verdict::Improvement ? " improvement"
+                                                                  : "";
+        if (c.verdict == Verdict::Regression) ++regressions;
+        std::println("{:<20} {:<45} {:>6} {:>6} B {:>10} - {:>12} -> {:>12} {}: {:>+7.2f}%{}",
+                     c.current.benchmark, c.current.queue, c.current.topology(),
+                     c.current.payload_bytes, c.current.metric,
+                     format_number(static_cast<long>(c.baseline.summary.median)),
+                     format_number(static_cast<long>(c.current.summary.median)), c.current.unit,
+                     100.0 * c.change, verdict);
+    }
+    std::println("{} of {} compared results regressed ({} had no baseline)", regressions,
+                 comparisons.size(), results.records().size() - comparisons.size());
+    return regressions;
+}
+
 int main(int argc, char* argv[]) {
-    spsc_benchmark_suite();
-    // mpmc_benchmark_suite();
-    // spmc_benchmark_suite();
-    // mpsc_benchmark_suite();
+    std::vector<Suite> suites;
+    std::string json_path;
+    std::string csv_path;
+    std::string baseline_path;
+    double threshold = 0.02;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(std::string(arg) + " needs a value");
+            return argv[++i];
+        };
+        try {
+            if (arg == "--list") {
+                for (const auto& suite : kSUITES) std::println("{}", suite.name);
+                return 0;
+            } else if (arg == "--json") {
+                json_path = value();
+            } else if (arg == "--csv") {
+                csv_path = value();
+            } else if (arg == "--baseline") {
+                baseline_path = value();
+            } else if (arg == "--threshold") {
+                threshold = std::stod(value());
+            } else if (arg == "--c2c-csv") {
+                core_to_core_csv = value();
+            } else if (arg == "--warmup") {
+                runner_config.warmup_runs = std::stoul(value());
+            } else if (arg == "--min-runs") {
+                runner_config.min_runs = std::stoul(value());
+            } else if (arg == "--max-runs") {
+                runner_config.max_runs = std::stoul(value());
+            } else if (arg == "--target-ci") {
+                runner_config.target_ci = std::stod(value());
+            } else if (arg == "--time-budget") {
+                runner_config.time_budget = duration_cast<nanoseconds>(
+                    duration<double>(std::stod(value())));
+            } else {
+                const auto suite = std::ranges::find(kSUITES, arg, &Suite::name);
+                if (suite == std::end(kSUITES))
+                    throw std::invalid_argument("unknown option or suite " + std::string(arg));
+                suites.push_back(*suite);
+            }
+        } catch (const std::exception& e) {
+            std::println(stderr, "{}", e.what());
+            print_usage(argv[0]);
+            return kEXIT_USAGE;
+        }
+    }
+    if (suites.empty())
+        suites.push_back(*std::ranges::find(kSUITES, std::string_view("spsc"), &Suite::name));
+
+    std::optional<std::vector<BenchmarkRecord>> baseline;
+    if (!baseline_path.empty()) {
+        baseline = load_baseline(baseline_path);
+        if (!baseline) return kEXIT_BAD_BASELINE;
+    }
+
+    for (const auto& suite : suites) suite.run();
+
+    const auto machine = MachineInfo::detect();
+    if (!json_path.empty()) {
+        std::ofstream file(json_path);
+        results.write_json(file, machine);
+    }
+    if (!csv_path.empty()) {
+        std::ofstream file(csv_path);
+        results.write_csv(file, machine);
+    }
+    if (baseline && compare_with_baseline(*baseline, baseline_path, threshold) != 0)
+        return kEXIT_REGRESSION;
 }